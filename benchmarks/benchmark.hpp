@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace uni_cpp_practice {
+
+namespace benchmark {
+
+class Timer {
+ public:
+  Timer() : start_(std::chrono::steady_clock::now()) {}
+
+  double elapsed_ms() const {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_)
+        .count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Запускает `run` `repeats` раз и возвращает медиану времени в миллисекундах
+template <typename Callback>
+double median_time_ms(int repeats, const Callback& run) {
+  std::vector<double> times;
+  times.reserve(repeats);
+  for (int i = 0; i < repeats; ++i) {
+    const auto timer = Timer();
+    run();
+    times.push_back(timer.elapsed_ms());
+  }
+  std::sort(times.begin(), times.end());
+  return times[times.size() / 2];
+}
+
+}  // namespace benchmark
+
+}  // namespace uni_cpp_practice
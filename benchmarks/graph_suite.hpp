@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../roman_kuprii/perf_counters.hpp"
+#include "benchmark.hpp"
+#include "graph_suite_baseline.hpp"
+
+// Same benchmarks for every Graph implementation. The implementations all
+// live in uni_cpp_practice or the global namespace under the same names, so
+// each one is linked into its own binary (graph_suite_<name>.cpp) through a
+// thin adapter:
+//
+//   struct Adapter {
+//     using Graph = ...;
+//     static constexpr bool HAS_IS_CONNECTED, HAS_GENERATOR, HAS_JSON;
+//     static void add_vertex(Graph& graph);
+//     // Called in creation order, `to` is a new vertex and `from` is its
+//     // parent, so depth-tracking implementations see a gray tree
+//     static void add_edge(Graph& graph, int from, int to);
+//     static bool is_connected(const Graph& graph, int from, int to);
+//     static Graph generate(int depth, int new_vertices_num);
+//     static int get_vertices_num(const Graph& graph);
+//     static std::string to_json(const Graph& graph);
+//   };
+//
+// Functions behind a false HAS_* flag can be left out. Every binary prints
+// CSV rows, graph_suite_report turns them into markdown tables. Built with
+// PERF_COUNTERS=1 the rows also have hardware counters per operation, left
+// empty where perf_event_open doesn't provide them. With --baseline the
+// binaries print every run instead (see graph_suite_baseline.hpp).
+
+namespace uni_cpp_practice {
+
+namespace benchmark {
+
+namespace graph_suite {
+
+constexpr int REPEATS = 5;
+// Enough runs for graph_suite_compare to tell a few percent apart
+constexpr int BASELINE_REPEATS = 15;
+constexpr int CHILDREN_NUM = 4;
+constexpr int QUERIES_NUM = 20000;
+constexpr int GENERATED_GRAPHS_NUM = 20;
+constexpr int NEW_VERTICES_NUM = 3;
+const std::vector<int> GRAPH_SIZES = {1000, 10000};
+const std::vector<int> GENERATION_DEPTHS = {3, 5};
+
+constexpr auto CSV_HEADER =
+    "implementation,benchmark,size,operations,median_ms,ns_per_operation,"
+    "cycles_per_operation,instructions_per_operation,"
+    "llc_misses_per_operation,branch_misses_per_operation";
+
+// Set by run_suite() from the command line
+struct Options {
+  int repeats = REPEATS;
+  bool writes_baseline = false;
+};
+
+inline Options& get_options() {
+  static Options options;
+  return options;
+}
+
+// Time and counters of the `operations` measured in a run, the setup isn't
+// counted
+struct Measurement {
+  double median_ms = 0;
+  long operations = 0;
+  perf_counters::Counts counts = {};
+  // Nanoseconds per operation of every run, set by measure()
+  std::vector<double> samples_ns;
+
+  void add(const Measurement& other) {
+    median_ms += other.median_ms;
+    operations += other.operations;
+    perf_counters::add_counts(counts, other.counts);
+  }
+};
+
+// Measures from construction to finish(), the counters are opened before
+// and read after the time so their syscalls stay out of it
+class Probe {
+ public:
+  Measurement finish(long operations) const {
+    const double elapsed_ms = timer_.elapsed_ms();
+    return {elapsed_ms, operations, counters_.read()};
+  }
+
+ private:
+  perf_counters::ThreadCounters counters_;
+  Timer timer_;
+};
+
+inline void print_row(const std::string& implementation,
+                      const std::string& benchmark,
+                      int size,
+                      const Measurement& measurement) {
+  if (get_options().writes_baseline) {
+    baseline::write_record(
+        std::cout, {implementation, benchmark, size, measurement.operations,
+                    measurement.samples_ns});
+    return;
+  }
+  std::cout << implementation << ',' << benchmark << ',' << size << ','
+            << measurement.operations << ',' << std::fixed
+            << std::setprecision(3) << measurement.median_ms << ','
+            << measurement.median_ms * 1e6 / measurement.operations;
+  for (const auto& count : measurement.counts) {
+    std::cout << ',';
+    if (count.has_value())
+      std::cout << static_cast<double>(count.value()) /
+                       measurement.operations;
+  }
+  std::cout << std::endl;
+}
+
+// `run` returns a Measurement of its measured part, the run with the median
+// time is kept along with the samples of all of them
+template <typename Run>
+Measurement measure(const Run& run) {
+  std::vector<Measurement> runs;
+  std::vector<double> samples_ns;
+  for (int i = 0; i < get_options().repeats; ++i) {
+    runs.push_back(run());
+    samples_ns.push_back(runs.back().median_ms * 1e6 /
+                         runs.back().operations);
+  }
+  std::sort(runs.begin(), runs.end(),
+            [](const Measurement& left, const Measurement& right) {
+              return left.median_ms < right.median_ms;
+            });
+  auto measurement = runs[runs.size() / 2];
+  measurement.samples_ns = samples_ns;
+  return measurement;
+}
+
+template <typename Adapter>
+typename Adapter::Graph make_vertices(int vertices_num) {
+  typename Adapter::Graph graph;
+  for (int i = 0; i < vertices_num; ++i)
+    Adapter::add_vertex(graph);
+  return graph;
+}
+
+template <typename Adapter>
+void add_tree_edges(typename Adapter::Graph& graph, int vertices_num) {
+  for (int vertex = 1; vertex < vertices_num; ++vertex)
+    Adapter::add_edge(graph, (vertex - 1) / CHILDREN_NUM, vertex);
+}
+
+template <typename Adapter>
+void run_build_benchmarks(const std::string& implementation, int size) {
+  print_row(implementation, "add_vertex", size, measure([size]() {
+              const auto probe = Probe();
+              const auto graph = make_vertices<Adapter>(size);
+              return probe.finish(size);
+            }));
+  print_row(implementation, "add_edge", size, measure([size]() {
+              auto graph = make_vertices<Adapter>(size);
+              const auto probe = Probe();
+              add_tree_edges<Adapter>(graph, size);
+              return probe.finish(size - 1);
+            }));
+
+  if constexpr (Adapter::HAS_IS_CONNECTED) {
+    auto graph = make_vertices<Adapter>(size);
+    add_tree_edges<Adapter>(graph, size);
+    // Half of the pairs are a vertex and its parent, half are random
+    auto engine = std::mt19937(size);
+    auto vertices = std::uniform_int_distribution<int>(1, size - 1);
+    std::vector<std::pair<int, int>> queries;
+    for (int i = 0; i < QUERIES_NUM; ++i) {
+      const int vertex = vertices(engine);
+      queries.emplace_back(i % 2 == 0 ? (vertex - 1) / CHILDREN_NUM
+                                      : vertices(engine),
+                           vertex);
+    }
+    int connected_num = 0;
+    print_row(implementation, "is_connected", size,
+              measure([&graph, &queries, &connected_num]() {
+                const auto probe = Probe();
+                for (const auto& [from, to] : queries)
+                  connected_num += Adapter::is_connected(graph, from, to);
+                return probe.finish(QUERIES_NUM);
+              }));
+    if (connected_num < get_options().repeats * QUERIES_NUM / 2)
+      std::cerr << implementation << ": parents not connected" << std::endl;
+  }
+}
+
+// Operations are generated vertices, the graphs' sizes differ between
+// implementations even with the same parameters
+template <typename Adapter>
+void run_generation_benchmarks(const std::string& implementation, int depth) {
+  if constexpr (Adapter::HAS_GENERATOR) {
+    print_row(implementation, "generate", depth, measure([depth]() {
+                Measurement measurement;
+                for (int i = 0; i < GENERATED_GRAPHS_NUM; ++i) {
+                  const auto probe = Probe();
+                  const auto graph =
+                      Adapter::generate(depth, NEW_VERTICES_NUM);
+                  auto graph_measurement = probe.finish(0);
+                  graph_measurement.operations =
+                      Adapter::get_vertices_num(graph);
+                  measurement.add(graph_measurement);
+                }
+                return measurement;
+              }));
+
+    if constexpr (Adapter::HAS_JSON) {
+      std::vector<typename Adapter::Graph> graphs;
+      for (int i = 0; i < GENERATED_GRAPHS_NUM; ++i)
+        graphs.push_back(Adapter::generate(depth, NEW_VERTICES_NUM));
+      std::size_t json_size = 0;
+      print_row(implementation, "json", depth,
+                measure([&graphs, &json_size]() {
+                  long vertices_num = 0;
+                  const auto probe = Probe();
+                  for (const auto& graph : graphs) {
+                    json_size += Adapter::to_json(graph).size();
+                    vertices_num += Adapter::get_vertices_num(graph);
+                  }
+                  return probe.finish(vertices_num);
+                }));
+      if (json_size == 0)
+        std::cerr << implementation << ": empty JSON" << std::endl;
+    }
+  }
+}
+
+// The constants a baseline's numbers depend on
+inline std::string get_params() {
+  std::ostringstream params;
+  params << "repeats " << get_options().repeats << ", children_num "
+         << CHILDREN_NUM << ", queries_num " << QUERIES_NUM
+         << ", generated_graphs_num " << GENERATED_GRAPHS_NUM
+         << ", new_vertices_num " << NEW_VERTICES_NUM << ", graph_sizes";
+  for (const int size : GRAPH_SIZES)
+    params << ' ' << size;
+  params << ", generation_depths";
+  for (const int depth : GENERATION_DEPTHS)
+    params << ' ' << depth;
+  return params.str();
+}
+
+// Prints the CSV header with --header. Otherwise runs every benchmark the
+// adapter supports, printing CSV rows or, with --baseline, a baseline.
+template <typename Adapter>
+int run_suite(const std::string& implementation, int argc, char** argv) {
+  if (argc > 1 && std::strcmp(argv[1], "--header") == 0) {
+    std::cout << CSV_HEADER << std::endl;
+    return 0;
+  }
+  if (argc > 1 && std::strcmp(argv[1], "--baseline") == 0) {
+    get_options() = {BASELINE_REPEATS, true};
+    baseline::write_header(std::cout, get_params());
+  }
+#ifdef PERF_COUNTERS
+  perf_counters::set_enabled(PERF_COUNTERS);
+#endif
+  for (const int size : GRAPH_SIZES)
+    run_build_benchmarks<Adapter>(implementation, size);
+  for (const int depth : GENERATION_DEPTHS)
+    run_generation_benchmarks<Adapter>(implementation, depth);
+  return 0;
+}
+
+}  // namespace graph_suite
+
+}  // namespace benchmark
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,42 @@
+#include <string>
+
+#include "../anton_potapov/graph.hpp"
+#include "../anton_potapov/graph_generator.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+// Header-only, vertices and edges in std::maps keyed by id
+struct Adapter {
+  using Graph = ::Graph;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  static constexpr bool HAS_GENERATOR = true;
+  static constexpr bool HAS_JSON = true;
+
+  static void add_vertex(Graph& graph) { graph.add_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.add_edge(from, to);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.is_connected(from, to);
+  }
+  static Graph generate(int depth, int new_vertices_num) {
+    return GraphGenerator(GraphGenerator::Params(depth, new_vertices_num))
+        .generate_graph();
+  }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.vertices().size();
+  }
+  // The generator leaves the depths updated, so the const overload is enough
+  static std::string to_json(const Graph& graph) {
+    return graph.get_json_string();
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "anton_potapov", argc, argv);
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/utsname.h>
+
+// Baselines of the graph suite: every run of every benchmark, so that two
+// builds can be compared with a significance test (graph_suite_compare).
+// A line-based text file, the header lines repeat when the binaries of the
+// implementations append to the same file:
+//
+//   graph_suite_baseline,<version>
+//   machine,<CPU model, CPUs count, OS, kernel, architecture>
+//   compiler,<version and flags>
+//   params,<the suite's constants>
+//   record,<implementation>,<benchmark>,<size>,<operations>,<median ns>,
+//       <p95 ns>,<ns per operation of every run, space separated>
+
+namespace uni_cpp_practice {
+
+namespace benchmark {
+
+namespace graph_suite {
+
+namespace baseline {
+
+constexpr auto MAGIC = "graph_suite_baseline";
+constexpr int VERSION = 1;
+
+struct Record {
+  std::string implementation;
+  std::string benchmark;
+  int size = 0;
+  long operations = 0;
+  // Nanoseconds per operation, a sample per run
+  std::vector<double> samples_ns;
+};
+
+struct Baseline {
+  std::string machine;
+  std::string compiler;
+  std::string params;
+  std::vector<Record> records;
+};
+
+// Nearest rank
+inline double get_percentile(std::vector<double> samples, int percentile) {
+  if (samples.empty())
+    return 0;
+  std::sort(samples.begin(), samples.end());
+  const auto rank = (percentile * samples.size() + 99) / 100;
+  return samples[std::max<std::size_t>(rank, 1) - 1];
+}
+
+inline std::string get_machine_fingerprint() {
+  std::string cpu_model = "unknown CPU";
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) == 0 &&
+        line.find(':') != std::string::npos) {
+      cpu_model = line.substr(line.find(':') + 2);
+      break;
+    }
+  }
+  std::ostringstream fingerprint;
+  fingerprint << cpu_model << ", " << std::thread::hardware_concurrency()
+              << " CPUs";
+  utsname system;
+  if (uname(&system) == 0)
+    fingerprint << ", " << system.sysname << ' ' << system.release << ' '
+                << system.machine;
+  return fingerprint.str();
+}
+
+inline std::string get_compiler() {
+  // Clang's version names it, GCC's is only the number
+#if defined(__GNUC__) && !defined(__clang__)
+  std::string compiler = "GCC " __VERSION__;
+#else
+  std::string compiler = __VERSION__;
+#endif
+#ifdef __OPTIMIZE__
+  compiler += ", optimized";
+#endif
+#ifdef NDEBUG
+  compiler += ", NDEBUG";
+#endif
+  return compiler;
+}
+
+inline void write_header(std::ostream& output, const std::string& params) {
+  output << MAGIC << ',' << VERSION << std::endl
+         << "machine," << get_machine_fingerprint() << std::endl
+         << "compiler," << get_compiler() << std::endl
+         << "params," << params << std::endl;
+}
+
+inline void write_record(std::ostream& output, const Record& record) {
+  output << "record," << record.implementation << ',' << record.benchmark
+         << ',' << record.size << ',' << record.operations << ','
+         << std::fixed << std::setprecision(3)
+         << get_percentile(record.samples_ns, 50) << ','
+         << get_percentile(record.samples_ns, 95) << ',';
+  for (std::size_t i = 0; i < record.samples_ns.size(); ++i)
+    output << (i > 0 ? " " : "") << record.samples_ns[i];
+  output << std::endl;
+}
+
+// Throws std::runtime_error on another version, on header lines that
+// disagree and on malformed records
+inline Baseline read_baseline(std::istream& input) {
+  Baseline baseline;
+  bool has_version = false;
+  // The header lines must agree wherever they repeat
+  const auto set_header = [](std::string& field, const std::string& value) {
+    if (!field.empty() && field != value)
+      throw std::runtime_error("Mixed baselines: " + field + " and " + value);
+    field = value;
+  };
+
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty())
+      continue;
+    const auto comma = line.find(',');
+    if (comma == std::string::npos)
+      throw std::runtime_error("Malformed line: " + line);
+    const auto kind = line.substr(0, comma);
+    const auto value = line.substr(comma + 1);
+    if (kind == MAGIC) {
+      if (value != std::to_string(VERSION))
+        throw std::runtime_error("Baseline version " + value +
+                                 ", expected " + std::to_string(VERSION));
+      has_version = true;
+    } else if (kind == "machine") {
+      set_header(baseline.machine, value);
+    } else if (kind == "compiler") {
+      set_header(baseline.compiler, value);
+    } else if (kind == "params") {
+      set_header(baseline.params, value);
+    } else if (kind == "record") {
+      std::istringstream fields(value);
+      Record record;
+      std::string size, operations, median, p95, samples;
+      if (!std::getline(fields, record.implementation, ',') ||
+          !std::getline(fields, record.benchmark, ',') ||
+          !std::getline(fields, size, ',') ||
+          !std::getline(fields, operations, ',') ||
+          !std::getline(fields, median, ',') ||
+          !std::getline(fields, p95, ',') || !std::getline(fields, samples))
+        throw std::runtime_error("Malformed record: " + line);
+      record.size = std::stoi(size);
+      record.operations = std::stol(operations);
+      std::istringstream samples_stream(samples);
+      double sample = 0;
+      while (samples_stream >> sample)
+        record.samples_ns.push_back(sample);
+      if (record.samples_ns.empty())
+        throw std::runtime_error("Record without samples: " + line);
+      baseline.records.push_back(record);
+    } else {
+      throw std::runtime_error("Unknown line: " + line);
+    }
+  }
+  if (!has_version)
+    throw std::runtime_error("Not a graph suite baseline");
+  return baseline;
+}
+
+}  // namespace baseline
+
+}  // namespace graph_suite
+
+}  // namespace benchmark
+
+}  // namespace uni_cpp_practice
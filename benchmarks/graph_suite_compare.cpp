@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "graph_suite_baseline.hpp"
+
+namespace {
+
+// A change is flagged when the rank-sum test rejects "same distribution"
+// at ALPHA, the confidence interval of the ratio of the medians leaves out
+// 1 and the medians differ by more than MIN_CHANGE
+constexpr double ALPHA = 0.01;
+constexpr double MIN_CHANGE = 0.02;
+constexpr int BOOTSTRAP_RESAMPLES = 2000;
+constexpr double CONFIDENCE = 0.95;
+
+namespace baseline = uni_cpp_practice::benchmark::graph_suite::baseline;
+
+// Implementation, benchmark and size
+using Key = std::tuple<std::string, std::string, int>;
+
+struct Comparison {
+  double old_median = 0;
+  double new_median = 0;
+  // Of new_median / old_median
+  double interval_low = 0;
+  double interval_high = 0;
+  double p_value = 1;
+};
+
+double get_median(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  const auto middle = samples.size() / 2;
+  return samples.size() % 2 == 1
+             ? samples[middle]
+             : (samples[middle - 1] + samples[middle]) / 2;
+}
+
+// Two-sided Mann-Whitney U test with the normal approximation and the tie
+// correction, fine from about 8 samples a side
+double get_rank_sum_p_value(const std::vector<double>& old_samples,
+                            const std::vector<double>& new_samples) {
+  std::vector<std::pair<double, bool>> values;
+  for (const double sample : old_samples)
+    values.emplace_back(sample, false);
+  for (const double sample : new_samples)
+    values.emplace_back(sample, true);
+  std::sort(values.begin(), values.end());
+
+  const double old_count = old_samples.size();
+  const double new_count = new_samples.size();
+  const double count = values.size();
+  double new_rank_sum = 0;
+  double ties_correction = 0;
+  for (std::size_t begin = 0; begin < values.size();) {
+    auto end = begin;
+    while (end < values.size() && values[end].first == values[begin].first)
+      ++end;
+    // Tied values share the mean of their ranks
+    const double rank = (begin + 1 + end) / 2.0;
+    for (auto i = begin; i < end; ++i)
+      if (values[i].second)
+        new_rank_sum += rank;
+    const double ties = end - begin;
+    ties_correction += ties * ties * ties - ties;
+    begin = end;
+  }
+
+  const double u = new_rank_sum - new_count * (new_count + 1) / 2;
+  const double mean = old_count * new_count / 2;
+  const double variance =
+      old_count * new_count / 12 *
+      ((count + 1) - ties_correction / (count * (count - 1)));
+  if (variance <= 0)
+    return 1;
+  // With the continuity correction
+  const double z =
+      std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+  return std::erfc(z / std::sqrt(2.0));
+}
+
+// Percentile bootstrap of new_median / old_median, seeded so that a
+// comparison prints the same every time
+std::pair<double, double> get_ratio_interval(
+    const std::vector<double>& old_samples,
+    const std::vector<double>& new_samples) {
+  auto engine = std::mt19937(old_samples.size() * 31 + new_samples.size());
+  const auto resample_median = [&engine](const std::vector<double>& samples) {
+    auto indices = std::uniform_int_distribution<std::size_t>(
+        0, samples.size() - 1);
+    std::vector<double> resample;
+    for (std::size_t i = 0; i < samples.size(); ++i)
+      resample.push_back(samples[indices(engine)]);
+    return get_median(resample);
+  };
+  std::vector<double> ratios;
+  for (int i = 0; i < BOOTSTRAP_RESAMPLES; ++i)
+    ratios.push_back(resample_median(new_samples) /
+                     resample_median(old_samples));
+  std::sort(ratios.begin(), ratios.end());
+  const double tail = (1 - CONFIDENCE) / 2;
+  return {ratios[static_cast<std::size_t>(tail * (ratios.size() - 1))],
+          ratios[static_cast<std::size_t>((1 - tail) * (ratios.size() - 1))]};
+}
+
+Comparison compare(const std::vector<double>& old_samples,
+                   const std::vector<double>& new_samples) {
+  Comparison comparison;
+  comparison.old_median = get_median(old_samples);
+  comparison.new_median = get_median(new_samples);
+  std::tie(comparison.interval_low, comparison.interval_high) =
+      get_ratio_interval(old_samples, new_samples);
+  comparison.p_value = get_rank_sum_p_value(old_samples, new_samples);
+  return comparison;
+}
+
+// "regression", "improvement" or empty
+std::string get_verdict(const Comparison& comparison) {
+  if (comparison.p_value >= ALPHA)
+    return "";
+  const double ratio = comparison.new_median / comparison.old_median;
+  if (comparison.interval_low > 1 && ratio > 1 + MIN_CHANGE)
+    return "regression";
+  if (comparison.interval_high < 1 && ratio < 1 - MIN_CHANGE)
+    return "improvement";
+  return "";
+}
+
+baseline::Baseline read_file(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Failed to open " + filename);
+  return baseline::read_baseline(file);
+}
+
+// The samples of repeated records are pooled
+std::map<Key, std::vector<double>> get_samples(
+    const baseline::Baseline& baseline) {
+  std::map<Key, std::vector<double>> samples;
+  for (const auto& record : baseline.records) {
+    auto& key_samples = samples[Key(record.implementation, record.benchmark,
+                                    record.size)];
+    key_samples.insert(key_samples.end(), record.samples_ns.begin(),
+                       record.samples_ns.end());
+  }
+  return samples;
+}
+
+void warn_if_differs(const std::string& name,
+                     const std::string& old_value,
+                     const std::string& new_value) {
+  if (old_value != new_value)
+    std::cout << "> **" << name << " differs:** " << old_value << " / "
+              << new_value << std::endl
+              << std::endl;
+}
+
+std::string format_number(double number, int precision) {
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(precision) << number;
+  return stream.str();
+}
+
+}  // namespace
+
+// Compares the baselines of two builds (graph_suite_<name> --baseline) in a
+// markdown table of nanoseconds per operation, exits with 1 if anything
+// regressed
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <old baseline> <new baseline>"
+              << std::endl;
+    return 2;
+  }
+  baseline::Baseline old_baseline;
+  baseline::Baseline new_baseline;
+  try {
+    old_baseline = read_file(argv[1]);
+    new_baseline = read_file(argv[2]);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 2;
+  }
+
+  warn_if_differs("Machine", old_baseline.machine, new_baseline.machine);
+  warn_if_differs("Compiler", old_baseline.compiler, new_baseline.compiler);
+  warn_if_differs("Params", old_baseline.params, new_baseline.params);
+
+  const auto old_samples = get_samples(old_baseline);
+  const auto new_samples = get_samples(new_baseline);
+  std::cout << "| implementation | benchmark | size | old ns | new ns | "
+               "change | "
+            << CONFIDENCE * 100 << "% CI | p | |" << std::endl
+            << "|---|---|---:|---:|---:|---:|---:|---:|---|" << std::endl;
+  int regressions_count = 0;
+  int improvements_count = 0;
+  for (const auto& [key, old_key_samples] : old_samples) {
+    const auto& [implementation, benchmark, size] = key;
+    const auto new_key_samples = new_samples.find(key);
+    if (new_key_samples == new_samples.end()) {
+      std::cout << "| " << implementation << " | " << benchmark << " | "
+                << size << " | - | - | - | - | - | only in old |" << std::endl;
+      continue;
+    }
+    const auto comparison = compare(old_key_samples, new_key_samples->second);
+    const auto verdict = get_verdict(comparison);
+    regressions_count += verdict == "regression";
+    improvements_count += verdict == "improvement";
+    const double change = comparison.new_median / comparison.old_median - 1;
+    std::cout << "| " << implementation << " | " << benchmark << " | " << size
+              << " | " << format_number(comparison.old_median, 1) << " | "
+              << format_number(comparison.new_median, 1) << " | "
+              << (change > 0 ? "+" : "") << format_number(change * 100, 1)
+              << "% | " << format_number((comparison.interval_low - 1) * 100, 1)
+              << "%.."
+              << format_number((comparison.interval_high - 1) * 100, 1)
+              << "% | " << format_number(comparison.p_value, 4) << " | "
+              << (verdict.empty() ? "" : "**" + verdict + "**") << " |"
+              << std::endl;
+  }
+  for (const auto& [key, new_key_samples] : new_samples)
+    if (old_samples.find(key) == old_samples.end())
+      std::cout << "| " << std::get<0>(key) << " | " << std::get<1>(key)
+                << " | " << std::get<2>(key)
+                << " | - | - | - | - | - | only in new |" << std::endl;
+
+  std::cout << std::endl
+            << regressions_count << " regressions, " << improvements_count
+            << " improvements (p < " << ALPHA << ", over "
+            << MIN_CHANGE * 100 << "%)" << std::endl;
+  return regressions_count > 0 ? 1 : 0;
+}
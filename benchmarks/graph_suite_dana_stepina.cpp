@@ -0,0 +1,29 @@
+#include "../dana_stepina/graph.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+// Vectors indexed by id, no color index
+struct Adapter {
+  using Graph = ::Graph;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  // GraphGenerator::generate() doesn't return the graph
+  static constexpr bool HAS_GENERATOR = false;
+  static constexpr bool HAS_JSON = false;
+
+  static void add_vertex(Graph& graph) { graph.add_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.add_edge(from, to);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.is_connected(from, to);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "dana_stepina", argc, argv);
+}
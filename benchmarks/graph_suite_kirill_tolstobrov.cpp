@@ -0,0 +1,43 @@
+#include <string>
+
+#include "../kirill_tolstobrov/graph.hpp"
+#include "../kirill_tolstobrov/graph_generator.hpp"
+#include "../kirill_tolstobrov/graph_printer.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+// Vectors indexed by id, adjacency and colors in std::maps
+struct Adapter {
+  using Graph = uni_cpp_practice::Graph;
+  using GraphGenerator = uni_cpp_practice::GraphGenerator;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  static constexpr bool HAS_GENERATOR = true;
+  static constexpr bool HAS_JSON = true;
+
+  static void add_vertex(Graph& graph) { graph.add_new_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.bind_vertices(from, to);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.are_vertices_connected(from, to);
+  }
+  static Graph generate(int depth, int new_vertices_num) {
+    return GraphGenerator(GraphGenerator::Params(depth, new_vertices_num))
+        .generate_random_graph();
+  }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.get_vertices().size();
+  }
+  static std::string to_json(const Graph& graph) {
+    return uni_cpp_practice::GraphPrinter(graph).print();
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "kirill_tolstobrov", argc, argv);
+}
@@ -0,0 +1,33 @@
+// task.cpp is the whole program, its main() is renamed out of the way
+#define main matveev_alexey_main
+#include "../matveev_alexey/task.cpp"
+#undef main
+
+#include "graph_suite.hpp"
+
+namespace {
+
+// Vectors searched by id, edge lists and layers in unordered_maps
+struct Adapter {
+  using Graph = ::Graph;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  // The generator picks from empty layers and crashes
+  static constexpr bool HAS_GENERATOR = false;
+  static constexpr bool HAS_JSON = false;
+
+  static void add_vertex(Graph& graph) { graph.addVertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.addEdge(from, to);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.areConnected(from, to);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "matveev_alexey", argc, argv);
+}
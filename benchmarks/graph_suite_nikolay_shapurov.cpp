@@ -0,0 +1,25 @@
+#include "../nikolay_shapurov/graph.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+// Only building is public, the edge lookup and the generator aren't
+struct Adapter {
+  using Graph = ::Graph;
+
+  static constexpr bool HAS_IS_CONNECTED = false;
+  static constexpr bool HAS_GENERATOR = false;
+  static constexpr bool HAS_JSON = false;
+
+  static void add_vertex(Graph& graph) { graph.add_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.add_edge(from, to);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "nikolay_shapurov", argc, argv);
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graph_suite.hpp"
+
+namespace {
+
+using uni_cpp_practice::benchmark::graph_suite::CSV_HEADER;
+
+// Benchmark and size, in the order the rows came
+using RowKey = std::pair<std::string, int>;
+
+// The per-operation columns of a row, the time and the hardware counters
+constexpr int FIRST_VALUE_COLUMN = 5;
+const std::vector<std::string> VALUE_NAMES = {
+    "ns", "cycles", "instructions", "llc_misses", "branch_misses"};
+
+struct Table {
+  std::vector<std::string> implementations;
+  std::vector<RowKey> rows;
+  // By VALUE_NAMES, a cell is left out when its field is empty
+  std::vector<std::map<RowKey, std::map<std::string, double>>> values =
+      std::vector<std::map<RowKey, std::map<std::string, double>>>(
+          VALUE_NAMES.size());
+};
+
+std::vector<std::string> split(const std::string& line) {
+  std::vector<std::string> fields;
+  std::istringstream stream(line);
+  std::string field;
+  while (std::getline(stream, field, ','))
+    fields.push_back(field);
+  return fields;
+}
+
+// Skips headers, empty lines and lines with too few fields. Trailing empty
+// counters are dropped by split(), so shorter lines are fine.
+void read_csv(std::istream& input, Table& table) {
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() || line == CSV_HEADER)
+      continue;
+    const auto fields = split(line);
+    if (fields.size() <= FIRST_VALUE_COLUMN ||
+        fields.size() > FIRST_VALUE_COLUMN + VALUE_NAMES.size()) {
+      std::cerr << "Skipping the line: " << line << std::endl;
+      continue;
+    }
+    const auto& implementation = fields[0];
+    const auto key = RowKey(fields[1], std::stoi(fields[2]));
+    if (std::find(table.implementations.begin(), table.implementations.end(),
+                  implementation) == table.implementations.end())
+      table.implementations.push_back(implementation);
+    if (std::find(table.rows.begin(), table.rows.end(), key) ==
+        table.rows.end())
+      table.rows.push_back(key);
+    for (std::size_t column = FIRST_VALUE_COLUMN; column < fields.size();
+         ++column)
+      if (!fields[column].empty())
+        table.values[column - FIRST_VALUE_COLUMN][key][implementation] =
+            std::stod(fields[column]);
+  }
+}
+
+// A value per operation, the lowest of a row in bold. Tables of counters
+// nobody has are left out.
+void print_markdown(const Table& table, std::size_t value_index) {
+  const auto& values = table.values[value_index];
+  if (value_index > 0) {
+    if (values.empty())
+      return;
+    std::cout << std::endl;
+  }
+  std::cout << "### " << VALUE_NAMES[value_index] << " per operation"
+            << std::endl
+            << std::endl;
+  std::cout << "| benchmark | size |";
+  for (const auto& implementation : table.implementations)
+    std::cout << ' ' << implementation << " |";
+  std::cout << std::endl << "|---|---:|";
+  for (std::size_t i = 0; i < table.implementations.size(); ++i)
+    std::cout << "---:|";
+  std::cout << std::endl;
+
+  for (const auto& key : table.rows) {
+    const auto row = values.find(key);
+    double lowest = std::numeric_limits<double>::max();
+    if (row != values.end())
+      for (const auto& [implementation, value] : row->second)
+        lowest = std::min(lowest, value);
+
+    std::cout << "| " << key.first << " | " << key.second << " |";
+    for (const auto& implementation : table.implementations) {
+      if (row == values.end() ||
+          row->second.find(implementation) == row->second.end()) {
+        std::cout << " - |";
+        continue;
+      }
+      const double value = row->second.at(implementation);
+      std::ostringstream cell;
+      cell << std::fixed << std::setprecision(1) << value;
+      if (value == lowest)
+        std::cout << " **" << cell.str() << "** |";
+      else
+        std::cout << ' ' << cell.str() << " |";
+    }
+    std::cout << std::endl;
+  }
+}
+
+}  // namespace
+
+// Turns the CSV of the graph_suite_<name> binaries into markdown tables of
+// the time and the counters, reads the files given or the standard input
+int main(int argc, char** argv) {
+  Table table;
+  if (argc == 1)
+    read_csv(std::cin, table);
+  for (int i = 1; i < argc; ++i) {
+    std::ifstream file(argv[i]);
+    if (!file.is_open()) {
+      std::cerr << "Failed to open " << argv[i] << std::endl;
+      return 1;
+    }
+    read_csv(file, table);
+  }
+  for (std::size_t i = 0; i < VALUE_NAMES.size(); ++i)
+    print_markdown(table, i);
+  return 0;
+}
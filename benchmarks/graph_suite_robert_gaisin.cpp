@@ -0,0 +1,33 @@
+// main.cpp is the whole program, its main() is renamed out of the way
+#define main robert_gaisin_main
+#include "../robert_gaisin/main.cpp"
+#undef main
+
+#include "graph_suite.hpp"
+
+namespace {
+
+// Vectors searched by id
+struct Adapter {
+  using Graph = ::Graph;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  // The generator picks from empty layers and crashes
+  static constexpr bool HAS_GENERATOR = false;
+  static constexpr bool HAS_JSON = false;
+
+  static void add_vertex(Graph& graph) { graph.add_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.add_edge(from, to, EdgeColor::Gray);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.is_connected(from, to);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "robert_gaisin", argc, argv);
+}
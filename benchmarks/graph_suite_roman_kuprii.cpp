@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <string>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+constexpr std::uint64_t SEED = 2021;
+
+// Vectors indexed by id, depth and color indexes kept by the graph
+struct Adapter {
+  using Graph = uni_cpp_practice::Graph;
+  using GraphGenerator = uni_cpp_practice::GraphGenerator;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  static constexpr bool HAS_GENERATOR = true;
+  static constexpr bool HAS_JSON = true;
+
+  static void add_vertex(Graph& graph) { graph.add_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.connect_vertices(from, to, true);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.is_connected(from, to);
+  }
+  // Seeded in call order, so every run of the binary generates the same
+  // gray trees and baselines compare the same work, up to the few painted
+  // edges that depend on thread interleaving
+  static Graph generate(int depth, int new_vertices_num) {
+    static std::uint64_t graphs_count = 0;
+    return GraphGenerator(GraphGenerator::Params(depth, new_vertices_num,
+                                                 SEED + graphs_count++))
+        .generate();
+  }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.get_vertices_num();
+  }
+  static std::string to_json(const Graph& graph) {
+    return uni_cpp_practice::graph_printing::graph_to_json(graph);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "roman_kuprii", argc, argv);
+}
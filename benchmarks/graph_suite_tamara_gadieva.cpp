@@ -0,0 +1,28 @@
+#include "../tamara_gadieva/graph.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+// Vectors indexed by id, no generator
+struct Adapter {
+  using Graph = ::Graph;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  static constexpr bool HAS_GENERATOR = false;
+  static constexpr bool HAS_JSON = false;
+
+  static void add_vertex(Graph& graph) { graph.add_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.add_edge(from, to);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.is_connected(from, to);
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "tamara_gadieva", argc, argv);
+}
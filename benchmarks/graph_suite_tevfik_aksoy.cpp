@@ -0,0 +1,43 @@
+#include <string>
+
+#include "../tevfik_aksoy/graph.hpp"
+#include "../tevfik_aksoy/graph_generator.hpp"
+#include "../tevfik_aksoy/graph_printer.hpp"
+#include "graph_suite.hpp"
+
+namespace {
+
+// Vectors indexed by id, colors in an unordered_map of edge id vectors
+struct Adapter {
+  using Graph = uni_cpp_practice::Graph;
+  using GraphGenerator = uni_cpp_practice::GraphGenerator;
+
+  static constexpr bool HAS_IS_CONNECTED = true;
+  static constexpr bool HAS_GENERATOR = true;
+  static constexpr bool HAS_JSON = true;
+
+  static void add_vertex(Graph& graph) { graph.insert_vertex(); }
+  static void add_edge(Graph& graph, int from, int to) {
+    graph.insert_edge(from, to);
+  }
+  static bool is_connected(const Graph& graph, int from, int to) {
+    return graph.are_vertices_connected(from, to);
+  }
+  static Graph generate(int depth, int new_vertices_num) {
+    return GraphGenerator(GraphGenerator::Params(depth, new_vertices_num))
+        .generate();
+  }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.get_vertices().size();
+  }
+  static std::string to_json(const Graph& graph) {
+    return uni_cpp_practice::GraphPrinter(graph).print();
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return uni_cpp_practice::benchmark::graph_suite::run_suite<Adapter>(
+      "tevfik_aksoy", argc, argv);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+// Checks the LevelOfDetail modes of the printers that have them against the
+// Full output, then times every mode on growing graphs. As in the graph
+// suite, each implementation is linked into its own binary
+// (level_of_detail_<name>.cpp) through an adapter:
+//
+//   struct Adapter {
+//     using Graph = ...;
+//     using LevelOfDetail = ...;
+//     // False when Full follows hash map order, the vertex and edge records
+//     // are then compared regardless of their order
+//     static constexpr bool IS_FULL_ORDERED;
+//     static Graph generate(int depth, int new_vertices_num);
+//     // Of the deepest vertex, may differ from the one asked for
+//     static int get_depth(const Graph& graph);
+//     static int get_vertices_num(const Graph& graph);
+//     static std::string print(const Graph& graph,
+//                              const LevelOfDetail& level_of_detail);
+//   };
+//
+// The binary exits with 1 when a mode that should print the whole graph
+// prints anything else.
+
+namespace uni_cpp_practice {
+
+namespace benchmark {
+
+namespace level_of_detail {
+
+constexpr int REPEATS = 5;
+constexpr int NEW_VERTICES_NUM = 3;
+constexpr int GRAPHS_PER_DEPTH = 3;
+// Not 0, which some generators divide by
+const std::vector<int> CHECK_DEPTHS = {1, 3, 5};
+const std::vector<int> TIMING_DEPTHS = {6, 9, 12};
+// Output of the timed modes, which shouldn't grow with the graph
+constexpr int TIMING_MAX_DEPTH = 2;
+constexpr int TIMING_SAMPLE_SIZE = 50;
+constexpr unsigned int SEED = 2021;
+
+// The text around the `{...}` records of the top-level arrays, then the
+// records sorted
+inline std::string normalize(const std::string& json) {
+  std::string skeleton;
+  std::vector<std::string> records;
+  int nesting = 0;
+  std::size_t record_start = 0;
+  for (std::size_t i = 0; i < json.size(); ++i) {
+    if (json[i] == '{' && nesting++ == 1)
+      record_start = i;
+    else if (json[i] == '}' && --nesting == 1)
+      records.push_back(json.substr(record_start, i + 1 - record_start));
+    else if (nesting <= 1)
+      skeleton += json[i];
+  }
+  std::sort(records.begin(), records.end());
+  for (const auto& record : records)
+    skeleton += record;
+  return skeleton;
+}
+
+template <typename Adapter>
+bool check_same_as_full(const std::string& mode_name,
+                        int depth,
+                        const typename Adapter::Graph& graph,
+                        const typename Adapter::LevelOfDetail& detail) {
+  const auto full = Adapter::print(graph, typename Adapter::LevelOfDetail());
+  const auto output = Adapter::print(graph, detail);
+  const bool is_same = Adapter::IS_FULL_ORDERED
+                           ? output == full
+                           : normalize(output) == normalize(full);
+  if (!is_same)
+    std::cout << "  FAILED: " << mode_name << " of a depth " << depth
+              << " graph with " << Adapter::get_vertices_num(graph)
+              << " vertices doesn't print the whole graph" << std::endl;
+  return is_same;
+}
+
+// Modes that select every vertex must print exactly what Full does
+template <typename Adapter>
+bool check_modes() {
+  using LevelOfDetail = typename Adapter::LevelOfDetail;
+  bool is_ok = true;
+  for (const int generated_depth : CHECK_DEPTHS)
+    for (int i = 0; i < GRAPHS_PER_DEPTH; ++i) {
+      const auto graph = Adapter::generate(generated_depth, NEW_VERTICES_NUM);
+      const int depth = Adapter::get_depth(graph);
+      const int vertices_num = Adapter::get_vertices_num(graph);
+      is_ok &= check_same_as_full<Adapter>(
+          "depth_limited(depth)", depth, graph,
+          LevelOfDetail::depth_limited(depth));
+      is_ok &= check_same_as_full<Adapter>(
+          "depth_limited(depth + 1)", depth, graph,
+          LevelOfDetail::depth_limited(depth + 1));
+      is_ok &= check_same_as_full<Adapter>(
+          "sampled(vertices)", depth, graph,
+          LevelOfDetail::sampled(vertices_num, SEED));
+      is_ok &= check_same_as_full<Adapter>(
+          "sampled(vertices + 1)", depth, graph,
+          LevelOfDetail::sampled(vertices_num + 1, SEED));
+    }
+  return is_ok;
+}
+
+// A row per graph and mode: the cost of Full follows the graph, the cost of
+// the other modes follows their output
+template <typename Adapter>
+void time_modes() {
+  using LevelOfDetail = typename Adapter::LevelOfDetail;
+  const std::vector<std::pair<std::string, LevelOfDetail>> modes = {
+      {"full", LevelOfDetail()},
+      {"depth_limited(" + std::to_string(TIMING_MAX_DEPTH) + ")",
+       LevelOfDetail::depth_limited(TIMING_MAX_DEPTH)},
+      {"sampled(" + std::to_string(TIMING_SAMPLE_SIZE) + ")",
+       LevelOfDetail::sampled(TIMING_SAMPLE_SIZE, SEED)},
+      {"summary", LevelOfDetail::summary()}};
+  std::cout << std::setw(10) << "vertices" << std::setw(20) << "mode"
+            << std::setw(12) << "bytes" << std::setw(12) << "us"
+            << std::endl;
+  volatile std::size_t printed_bytes = 0;
+  for (const int depth : TIMING_DEPTHS) {
+    const auto graph = Adapter::generate(depth, NEW_VERTICES_NUM);
+    for (const auto& mode : modes) {
+      const auto& level_of_detail = mode.second;
+      const auto bytes = Adapter::print(graph, level_of_detail).size();
+      const double time_ms = median_time_ms(REPEATS, [&]() {
+        printed_bytes = Adapter::print(graph, level_of_detail).size();
+      });
+      std::cout << std::setw(10) << Adapter::get_vertices_num(graph)
+                << std::setw(20) << mode.first << std::setw(12) << bytes
+                << std::setw(12) << std::fixed << std::setprecision(1)
+                << time_ms * 1000 << std::endl;
+    }
+  }
+}
+
+template <typename Adapter>
+int run_level_of_detail(const std::string& implementation) {
+  std::cout << implementation << std::endl;
+  const bool is_ok = check_modes<Adapter>();
+  time_modes<Adapter>();
+  return is_ok ? 0 : 1;
+}
+
+}  // namespace level_of_detail
+
+}  // namespace benchmark
+
+}  // namespace uni_cpp_practice
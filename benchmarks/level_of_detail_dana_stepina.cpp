@@ -0,0 +1,76 @@
+#include <cstddef>
+#include <random>
+#include <string>
+
+#include "../dana_stepina/graph.hpp"
+#include "../dana_stepina/graph_printer.hpp"
+#include "level_of_detail.hpp"
+
+namespace {
+
+struct Adapter {
+  using Graph = ::Graph;
+  using LevelOfDetail = ::LevelOfDetail;
+
+  static constexpr bool IS_FULL_ORDERED = true;
+
+  // GraphGenerator divides by zero when the gray tree stops at depth 1, so
+  // the graphs are grown here through the Graph API: a gray tree with the
+  // generators' probabilities, then every fourth vertex gets a green, a
+  // yellow and a red edge where it can
+  static Graph generate(int depth, int new_vertices_num) {
+    static std::mt19937 engine;
+    Graph graph;
+    graph.add_vertex();
+    for (int parent_depth = 0; parent_depth < depth; ++parent_depth) {
+      const auto probability =
+          static_cast<double>(depth - parent_depth) / depth;
+      // Copied, the children are moved out of depth 0 into the depth map
+      const auto parent_ids = graph.get_vertex_ids_at(parent_depth);
+      for (const auto& parent_id : parent_ids)
+        for (int i = 0; i < new_vertices_num; ++i)
+          if (std::bernoulli_distribution(probability)(engine))
+            graph.add_edge(parent_id, graph.add_vertex().id);
+      if (static_cast<int>(graph.get_depth_map().size()) == parent_depth + 1)
+        break;
+    }
+
+    const auto& depth_map = graph.get_depth_map();
+    const auto connect_to_depth = [&graph, &depth_map](VertexId vertex_id,
+                                                       std::size_t depth) {
+      if (depth >= depth_map.size())
+        return;
+      for (const auto& other_id : depth_map[depth])
+        if (!graph.is_connected(vertex_id, other_id)) {
+          graph.add_edge(vertex_id, other_id);
+          return;
+        }
+    };
+    for (std::size_t vertex_id = 0; vertex_id < graph.get_vertices().size();
+         vertex_id += 4) {
+      const std::size_t vertex_depth = graph.get_vertex(vertex_id).depth;
+      if (!graph.get_vertex(vertex_id).get_edge_ids().empty())
+        graph.add_edge(vertex_id, vertex_id);
+      connect_to_depth(vertex_id, vertex_depth + 1);
+      connect_to_depth(vertex_id, vertex_depth + 2);
+    }
+    return graph;
+  }
+  static int get_depth(const Graph& graph) {
+    return graph.get_depth_map().size() - 1;
+  }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.get_vertices().size();
+  }
+  static std::string print(const Graph& graph,
+                           const LevelOfDetail& level_of_detail) {
+    return GraphPrinter(graph, level_of_detail).print();
+  }
+};
+
+}  // namespace
+
+int main() {
+  return uni_cpp_practice::benchmark::level_of_detail::run_level_of_detail<
+      Adapter>("dana_stepina");
+}
@@ -0,0 +1,38 @@
+#include <string>
+
+#include "../kirill_tolstobrov/graph.hpp"
+#include "../kirill_tolstobrov/graph_generator.hpp"
+#include "../kirill_tolstobrov/graph_printer.hpp"
+#include "level_of_detail.hpp"
+
+namespace {
+
+struct Adapter {
+  using Graph = uni_cpp_practice::Graph;
+  using GraphGenerator = uni_cpp_practice::GraphGenerator;
+  using LevelOfDetail = uni_cpp_practice::LevelOfDetail;
+
+  static constexpr bool IS_FULL_ORDERED = true;
+
+  static Graph generate(int depth, int new_vertices_num) {
+    return GraphGenerator(GraphGenerator::Params(depth, new_vertices_num))
+        .generate_random_graph();
+  }
+  static int get_depth(const Graph& graph) {
+    return graph.depths_map_.size() - 1;
+  }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.get_vertices().size();
+  }
+  static std::string print(const Graph& graph,
+                           const LevelOfDetail& level_of_detail) {
+    return uni_cpp_practice::GraphPrinter(graph, level_of_detail).print();
+  }
+};
+
+}  // namespace
+
+int main() {
+  return uni_cpp_practice::benchmark::level_of_detail::run_level_of_detail<
+      Adapter>("kirill_tolstobrov");
+}
@@ -0,0 +1,37 @@
+#include <string>
+
+#include "../novikov_dmitry/graph.hpp"
+#include "../novikov_dmitry/graph_generator.hpp"
+#include "../novikov_dmitry/graph_printer.hpp"
+#include "level_of_detail.hpp"
+
+namespace {
+
+struct Adapter {
+  using Graph = uni_cpp_practice::Graph;
+  using GraphGenerator = uni_cpp_practice::GraphGenerator;
+  using LevelOfDetail = uni_cpp_practice::LevelOfDetail;
+
+  // Full walks the unordered_maps of vertices and edges
+  static constexpr bool IS_FULL_ORDERED = false;
+
+  static Graph generate(int depth, int new_vertices_num) {
+    return GraphGenerator(GraphGenerator::Params(depth, new_vertices_num))
+        .generate();
+  }
+  static int get_depth(const Graph& graph) { return graph.get_depth(); }
+  static int get_vertices_num(const Graph& graph) {
+    return graph.get_vertex_map().size();
+  }
+  static std::string print(const Graph& graph,
+                           const LevelOfDetail& level_of_detail) {
+    return uni_cpp_practice::GraphPrinter(graph, level_of_detail).print();
+  }
+};
+
+}  // namespace
+
+int main() {
+  return uni_cpp_practice::benchmark::level_of_detail::run_level_of_detail<
+      Adapter>("novikov_dmitry");
+}
@@ -0,0 +1,57 @@
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../novikov_dmitry/graph.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int CHILDREN_NUM = 3;
+
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::VertexId;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+// Все вершины сначала лежат на нулевом уровне, затем серые ребра
+// переносят их на свои уровни - худший случай для уровня 0
+void build_batch_tree(int vertices_num) {
+  auto graph = Graph();
+  graph.add_vertex();
+  for (int i = 1; i < vertices_num; ++i) {
+    graph.add_vertex();
+  }
+  for (VertexId id = 1; id < vertices_num; ++id) {
+    graph.add_edge((id - 1) / CHILDREN_NUM, id);
+  }
+}
+
+// Порядок, в котором вершины добавляет генератор
+void build_interleaved_tree(int vertices_num) {
+  auto graph = Graph();
+  graph.add_vertex();
+  for (VertexId id = 1; id < vertices_num; ++id) {
+    graph.add_edge((id - 1) / CHILDREN_NUM, graph.add_vertex());
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::cout << std::setw(10) << "vertices" << std::setw(16) << "batch ns/edge"
+            << std::setw(22) << "interleaved ns/edge" << std::endl;
+  for (int vertices_num = 1 << 12; vertices_num <= 1 << 18;
+       vertices_num <<= 1) {
+    const double batch_ms = median_time_ms(
+        REPEATS, [vertices_num]() { build_batch_tree(vertices_num); });
+    const double interleaved_ms = median_time_ms(
+        REPEATS, [vertices_num]() { build_interleaved_tree(vertices_num); });
+    const double edges_num = vertices_num - 1;
+    std::cout << std::setw(10) << vertices_num << std::setw(16) << std::fixed
+              << std::setprecision(1) << batch_ms * 1e6 / edges_num
+              << std::setw(22) << interleaved_ms * 1e6 / edges_num
+              << std::endl;
+  }
+  return 0;
+}
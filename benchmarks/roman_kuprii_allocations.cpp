@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+
+#include "../roman_kuprii/allocation_profiler.hpp"
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generation_controller.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "../roman_kuprii/logging_helping.hpp"
+
+namespace {
+
+constexpr int GRAPHS_COUNT = 20;
+constexpr int DEPTH = 5;
+constexpr int NEW_VERTICES_NUM = 3;
+
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::allocation_profiler::Phase;
+using uni_cpp_practice::allocation_profiler::Scope;
+using uni_cpp_practice::graph_generation_controller::GraphGenerationController;
+
+namespace graph_printing = uni_cpp_practice::graph_printing;
+namespace logging_helping = uni_cpp_practice::logging_helping;
+
+}  // namespace
+
+// Built with ALLOCATION_PROFILER=1: the allocations of every phase of a
+// graph's job, including the log messages of main() and both JSON printers,
+// to compare between changes of Graph, GraphGenerator and the printers
+int main() {
+  if (!uni_cpp_practice::allocation_profiler::is_enabled()) {
+    std::cerr << "Built without ALLOCATION_PROFILER=1" << std::endl;
+    return 1;
+  }
+  const auto params = GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM);
+  auto controller = GraphGenerationController(1, GRAPHS_COUNT, params);
+  std::size_t output_size = 0;
+  // Reused like a long-lived output buffer, so it stops allocating
+  std::string json_buffer;
+
+  controller.generate(
+      [&output_size](int index) {
+        const auto allocation_scope = Scope(Phase::Logging);
+        output_size += logging_helping::write_log_start(index).size();
+      },
+      [&output_size, &json_buffer](const Graph& graph, int index) {
+        {
+          const auto allocation_scope = Scope(Phase::Logging);
+          output_size += logging_helping::write_log_end(graph, index).size();
+        }
+        const auto allocation_scope = Scope(Phase::Json);
+        output_size += graph_printing::graph_to_json(graph).size();
+        json_buffer.clear();
+        graph_printing::write_graph_json(graph, json_buffer);
+        output_size += json_buffer.size();
+      });
+
+  std::cout << uni_cpp_practice::graph_generation_controller::
+                   format_graph_allocations(controller.get_graph_allocations());
+  if (output_size == 0)
+    std::cerr << "Nothing was printed" << std::endl;
+  return 0;
+}
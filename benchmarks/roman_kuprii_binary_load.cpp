@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_binary.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "../roman_kuprii/graph_reading.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int VERTICES_NUM = 1 << 20;
+constexpr int CHILDREN_NUM = 4;
+
+const std::string JSON_FILENAME = "roman_kuprii_binary_load.json";
+const std::string BINARY_FILENAME = "roman_kuprii_binary_load.bin";
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::VertexId;
+using uni_cpp_practice::benchmark::median_time_ms;
+using uni_cpp_practice::benchmark::Timer;
+
+namespace graph_binary = uni_cpp_practice::graph_binary;
+
+// The generator is too slow for graphs of this size, so build a complete
+// tree with blue edges between neighbours on a level instead
+Graph make_graph() {
+  Graph graph;
+  graph.reserve(VERTICES_NUM, 2 * VERTICES_NUM);
+  std::vector<int> depths = {0};
+  graph.restore_vertex(0);
+  for (VertexId vertex_id = 1; vertex_id < VERTICES_NUM; ++vertex_id) {
+    const VertexId parent_id = (vertex_id - 1) / CHILDREN_NUM;
+    depths.push_back(depths[parent_id] + 1);
+    graph.restore_vertex(depths.back());
+  }
+  for (VertexId vertex_id = 1; vertex_id < VERTICES_NUM; ++vertex_id)
+    graph.restore_edge((vertex_id - 1) / CHILDREN_NUM, vertex_id,
+                       Edge::Color::Gray);
+  for (VertexId vertex_id = 2; vertex_id < VERTICES_NUM; ++vertex_id)
+    if (depths[vertex_id - 1] == depths[vertex_id])
+      graph.restore_edge(vertex_id - 1, vertex_id, Edge::Color::Blue);
+  return graph;
+}
+
+void report(const std::string& name, double elapsed_ms) {
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3)
+            << elapsed_ms << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  const auto graph = make_graph();
+  graph_binary::write_graph_binary(graph, BINARY_FILENAME);
+  graph_binary::binary_to_json(BINARY_FILENAME, JSON_FILENAME);
+  std::cout << "graph: " << graph.get_vertices_num() << " vertices, "
+            << graph.get_edges_num() << " edges" << std::endl;
+  std::cout << std::setw(28) << std::left << "load" << std::right
+            << std::setw(12) << "ms" << std::endl;
+
+  long long sink = 0;
+  report("read_graph_json", median_time_ms(REPEATS, [&sink]() {
+           const auto loaded =
+               uni_cpp_practice::graph_reading::read_graph_json(
+                   JSON_FILENAME);
+           sink += loaded.get_edges_num();
+         }));
+  report("GraphView", median_time_ms(REPEATS, [&sink]() {
+           const auto view = graph_binary::GraphView(BINARY_FILENAME);
+           sink += view.get_vertex_edge_ids(view.get_vertices_num() - 1)[0];
+         }));
+  report("GraphView, full scan", median_time_ms(REPEATS, [&sink]() {
+           const auto view = graph_binary::GraphView(BINARY_FILENAME);
+           for (const auto& vertex_id : view.get_edge_vertices())
+             sink += vertex_id;
+         }));
+  report("GraphView::to_graph", median_time_ms(REPEATS, [&sink]() {
+           const auto view = graph_binary::GraphView(BINARY_FILENAME);
+           sink += view.to_graph().get_edges_num();
+         }));
+
+  std::remove(JSON_FILENAME.c_str());
+  std::remove(BINARY_FILENAME.c_str());
+  return sink == 0;
+}
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_compression.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "../roman_kuprii/graph_reading.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 21;
+constexpr int DEPTH = 6;
+constexpr int NEW_VERTICES_NUM = 5;
+
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+namespace graph_compression = uni_cpp_practice::graph_compression;
+namespace graph_printing = uni_cpp_practice::graph_printing;
+
+// Edge ids lists of all vertices, each one delta-encoded
+std::vector<std::uint32_t> make_adjacency_gaps(const Graph& graph) {
+  std::vector<std::uint32_t> gaps;
+  for (const auto& vertex : graph.get_vertices()) {
+    int previous_edge_id = 0;
+    for (const auto& edge_id : vertex.get_edges_ids()) {
+      gaps.push_back(edge_id - previous_edge_id);
+      previous_edge_id = edge_id;
+    }
+  }
+  return gaps;
+}
+
+void report_size(const std::string& name, std::size_t bytes, int edges_num) {
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(12) << bytes << std::setw(12) << std::fixed
+            << std::setprecision(2) << double(bytes) / edges_num << std::endl;
+}
+
+void report_time(const std::string& name,
+                 std::size_t bytes,
+                 double elapsed_ms) {
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3)
+            << elapsed_ms << std::setw(12) << std::setprecision(2)
+            << bytes / elapsed_ms / 1e6 << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  const auto graph =
+      GraphGenerator(GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM))
+          .generate();
+  const auto json = graph_printing::graph_to_json(graph);
+  std::string compressed;
+  graph_compression::compress_graph(graph, compressed);
+  if (graph_printing::graph_to_json(
+          graph_compression::decompress_graph(compressed)) != json) {
+    std::cerr << "Decompressed graph differs from the original" << std::endl;
+    return 1;
+  }
+
+  const auto gaps = make_adjacency_gaps(graph);
+  std::string packed_gaps;
+  graph_compression::encode_integers(gaps.data(), gaps.size(), packed_gaps);
+  std::vector<std::uint32_t> decoded(gaps.size());
+  graph_compression::decode_integers(packed_gaps, decoded.data(),
+                                     decoded.size());
+  const auto decoded_simd = decoded;
+  graph_compression::decode_integers_scalar(packed_gaps, decoded.data(),
+                                            decoded.size());
+  if (decoded != gaps || decoded_simd != gaps) {
+    std::cerr << "Decoded integers differ from the encoded" << std::endl;
+    return 1;
+  }
+
+  std::cout << "graph: " << graph.get_vertices_num() << " vertices, "
+            << graph.get_edges_num() << " edges" << std::endl;
+  std::cout << std::setw(28) << std::left << "format" << std::right
+            << std::setw(12) << "bytes" << std::setw(12) << "B/edge"
+            << std::endl;
+  report_size("JSON", json.size(), graph.get_edges_num());
+  report_size("compressed", compressed.size(), graph.get_edges_num());
+  report_size("packed adjacency gaps", packed_gaps.size(),
+              graph.get_edges_num());
+
+  // Speeds in GB of the JSON text, or of the decoded integers
+  std::cout << std::setw(28) << std::left << "decoder" << std::right
+            << std::setw(12) << "ms" << std::setw(12) << "GB/s" << std::endl;
+  long long sink = 0;
+  report_time("graph_from_json", json.size(),
+              median_time_ms(REPEATS, [&json, &sink]() {
+                sink += uni_cpp_practice::graph_reading::graph_from_json(json)
+                            .get_edges_num();
+              }));
+  report_time("decompress_graph", json.size(),
+              median_time_ms(REPEATS, [&compressed, &sink]() {
+                sink += graph_compression::decompress_graph(compressed)
+                            .get_edges_num();
+              }));
+  const std::size_t decoded_size = gaps.size() * sizeof(std::uint32_t);
+  report_time("decode_integers", decoded_size,
+              median_time_ms(REPEATS, [&packed_gaps, &decoded, &sink]() {
+                sink += graph_compression::decode_integers(
+                    packed_gaps, decoded.data(), decoded.size());
+              }));
+  report_time("decode_integers_scalar", decoded_size,
+              median_time_ms(REPEATS, [&packed_gaps, &decoded, &sink]() {
+                sink += graph_compression::decode_integers_scalar(
+                    packed_gaps, decoded.data(), decoded.size());
+              }));
+  return sink == 0;
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../roman_kuprii/date_time.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int CALLS_PER_THREAD = 200000;
+const std::vector<int> THREADS_COUNTS = {1, 4};
+
+namespace date_time = uni_cpp_practice::date_time;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+namespace legacy {
+
+// What logging_helping did before the cache
+std::string get_datetime() {
+  const auto date_time = std::chrono::system_clock::now();
+  const auto date_time_t = std::chrono::system_clock::to_time_t(date_time);
+  std::stringstream date_time_string;
+  date_time_string << std::put_time(std::localtime(&date_time_t),
+                                    "%Y.%m.%d %H:%M:%S");
+  return date_time_string.str();
+}
+
+}  // namespace legacy
+
+// Millions of timestamps per second over all threads
+template <typename Format>
+double measure(int threads_count, const Format& format) {
+  const double ms = median_time_ms(REPEATS, [threads_count, &format]() {
+    std::vector<std::thread> threads;
+    for (int thread_id = 0; thread_id < threads_count; ++thread_id)
+      threads.emplace_back([&format]() {
+        std::size_t length = 0;
+        for (int i = 0; i < CALLS_PER_THREAD; ++i)
+          length += format();
+        if (length == 0)
+          std::cerr << "Empty timestamps" << std::endl;
+      });
+    for (auto& thread : threads)
+      thread.join();
+  });
+  return threads_count * CALLS_PER_THREAD / ms / 1e3;
+}
+
+}  // namespace
+
+int main() {
+  // std::localtime shares its result between threads, so the legacy version
+  // only runs on one
+  const double legacy_rate =
+      measure(1, []() { return legacy::get_datetime().size(); });
+  if (legacy::get_datetime() != date_time::get_datetime())
+    std::cout << "Timestamps differ, the second must have changed"
+              << std::endl;
+  std::cout << "Example: " << date_time::get_precise_datetime() << std::endl;
+
+  std::cout << std::setw(28) << std::left << "formatter" << std::right
+            << std::setw(10) << "threads" << std::setw(14) << "M stamps/s"
+            << std::endl;
+  const auto report = [](const std::string& name, int threads_count,
+                         double rate) {
+    std::cout << std::setw(28) << std::left << name << std::right
+              << std::setw(10) << threads_count << std::setw(14) << std::fixed
+              << std::setprecision(2) << rate << std::endl;
+  };
+  report("stringstream + put_time", 1, legacy_rate);
+  for (const int threads_count : THREADS_COUNTS) {
+    report("get_datetime", threads_count, measure(threads_count, []() {
+             return date_time::get_datetime().size();
+           }));
+    report("get_precise_datetime", threads_count, measure(threads_count, []() {
+             return date_time::get_precise_datetime().size();
+           }));
+  }
+  return 0;
+}
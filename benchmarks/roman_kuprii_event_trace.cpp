@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/event_trace.hpp"
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/logging_helping.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int GRAPHS_NUM = 200;
+// Passes over the graphs per measurement
+constexpr int ROUNDS = 50;
+constexpr int DEPTH = 5;
+constexpr int NEW_VERTICES_NUM = 4;
+
+const std::string TRACE_FILENAME = "roman_kuprii_event_trace.trace";
+
+namespace event_trace = uni_cpp_practice::event_trace;
+namespace logging_helping = uni_cpp_practice::logging_helping;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+void report(const std::string& name, double ms) {
+  std::cout << std::setw(32) << std::left << name << std::right
+            << std::setw(14) << std::fixed << std::setprecision(1)
+            << ms * 1e6 / (ROUNDS * GRAPHS_NUM) << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  const auto generator =
+      GraphGenerator(GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM));
+  std::vector<Graph> graphs;
+  for (int i = 0; i < GRAPHS_NUM; ++i)
+    graphs.push_back(generator.generate());
+
+  std::size_t sink = 0;
+  const double text_ms = median_time_ms(REPEATS, [&graphs, &sink]() {
+    for (int round = 0; round < ROUNDS; ++round)
+      for (int index = 0; index < GRAPHS_NUM; ++index) {
+        const auto& graph = graphs[index];
+        sink += logging_helping::write_log_start(index).size();
+        sink += logging_helping::write_log_end(graph, index).size();
+      }
+  });
+  // The file is opened once, as main does
+  auto trace = event_trace::TraceWriter(TRACE_FILENAME);
+  const double trace_ms = median_time_ms(REPEATS, [&graphs, &trace]() {
+    for (int round = 0; round < ROUNDS; ++round)
+      for (int index = 0; index < GRAPHS_NUM; ++index) {
+        trace.record(event_trace::make_started_event(index));
+        trace.record(event_trace::make_finished_event(graphs[index], index));
+      }
+  });
+  trace.close();
+
+  const auto events = event_trace::read_events(TRACE_FILENAME);
+  std::remove(TRACE_FILENAME.c_str());
+  if (events.size() != 2 * REPEATS * ROUNDS * GRAPHS_NUM ||
+      events.back().vertices_num != graphs.back().get_vertices_num()) {
+    std::cerr << "Trace doesn't match the graphs" << std::endl;
+    return 1;
+  }
+
+  std::cout << GRAPHS_NUM << " graphs of " << graphs.front().get_vertices_num()
+            << " vertices, " << sizeof(event_trace::Event) << " bytes per event"
+            << std::endl;
+  std::cout << std::setw(32) << std::left << "per graph" << std::right
+            << std::setw(14) << "ns" << std::endl;
+  report("write_log_start + write_log_end", text_ms);
+  report("trace events", trace_ms);
+  return sink == 0;
+}
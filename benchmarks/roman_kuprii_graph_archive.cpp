@@ -0,0 +1,104 @@
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_archive.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int GRAPHS_NUM = 20000;
+constexpr int DISTINCT_GRAPHS_NUM = 100;
+constexpr int DEPTH = 3;
+constexpr int NEW_VERTICES_NUM = 3;
+
+const std::string DIRECTORY_NAME = "roman_kuprii_graph_archive";
+const std::string ARCHIVE_FILENAME = DIRECTORY_NAME + "/graphs.archive";
+
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::benchmark::median_time_ms;
+using uni_cpp_practice::graph_archive::ArchiveReader;
+using uni_cpp_practice::graph_archive::ArchiveWriter;
+
+namespace graph_printing = uni_cpp_practice::graph_printing;
+
+// What main did before the archive: a file per graph
+void write_files(const std::vector<std::string>& jsons) {
+  for (int graph_id = 0; graph_id < GRAPHS_NUM; ++graph_id) {
+    const auto& json = jsons[graph_id % jsons.size()];
+    std::ofstream out(DIRECTORY_NAME + "/graph_" + std::to_string(graph_id) +
+                          ".json",
+                      std::ofstream::trunc);
+    out.write(json.data(), json.size());
+  }
+}
+
+void write_archive(const std::vector<std::string>& jsons,
+                   const GraphGenerator::Params& params) {
+  auto archive = ArchiveWriter(ARCHIVE_FILENAME);
+  for (int graph_id = 0; graph_id < GRAPHS_NUM; ++graph_id)
+    archive.append(graph_id, params, 0, jsons[graph_id % jsons.size()]);
+  archive.close();
+}
+
+void report(const std::string& name, double elapsed_ms) {
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << elapsed_ms << std::setw(14) << GRAPHS_NUM / elapsed_ms * 1000
+            << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  // Generation isn't measured, a few graphs are written many times
+  const auto params = GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM);
+  const auto generator = GraphGenerator(params);
+  std::vector<std::string> jsons;
+  for (int i = 0; i < DISTINCT_GRAPHS_NUM; ++i)
+    jsons.push_back(graph_printing::graph_to_json(generator.generate()));
+
+  std::filesystem::remove_all(DIRECTORY_NAME);
+  std::filesystem::create_directory(DIRECTORY_NAME);
+  write_archive(jsons, params);
+  {
+    const ArchiveReader archive(ARCHIVE_FILENAME);
+    int graph_id = 0;
+    for (const auto& record : archive) {
+      if (record.entry.graph_id != graph_id ||
+          record.json != jsons[graph_id % jsons.size()]) {
+        std::cerr << "Archive differs from the written graphs" << std::endl;
+        return 1;
+      }
+      ++graph_id;
+    }
+  }
+
+  std::cout << GRAPHS_NUM << " graphs" << std::endl;
+  std::cout << std::setw(28) << std::left << "writer" << std::right
+            << std::setw(12) << "ms" << std::setw(14) << "graphs/s"
+            << std::endl;
+  report("file per graph",
+         median_time_ms(REPEATS, [&jsons]() { write_files(jsons); }));
+  report("archive", median_time_ms(REPEATS, [&jsons, &params]() {
+           write_archive(jsons, params);
+         }));
+
+  long long sink = 0;
+  report("archive, open + read all", median_time_ms(REPEATS, [&sink]() {
+           const ArchiveReader archive(ARCHIVE_FILENAME);
+           for (const auto& record : archive)
+             sink += record.json.back();
+         }));
+
+  std::filesystem::remove_all(DIRECTORY_NAME);
+  return sink == 0;
+}
@@ -0,0 +1,137 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generation_controller.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+std::atomic<long long> allocations_count = 0;
+
+constexpr int GRAPHS_COUNT = 100;
+constexpr int DEPTH = 6;
+constexpr int NEW_VERTICES_NUM = 4;
+// Repeats the gray trees of the warm-up batch, so a recycled graph doesn't
+// meet a bigger one after it
+constexpr std::uint64_t SEED = 2021;
+// What's left is the controller's storage of the batch
+constexpr double MAX_STEADY_ALLOCATIONS_PER_GRAPH = 1;
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::benchmark::Timer;
+using uni_cpp_practice::graph_generation_controller::GraphGenerationController;
+
+// Repeats the insertions the generator made for `reference`
+void replay_graph(const Graph& reference, Graph& graph) {
+  graph.add_vertex();
+  for (const auto& edge : reference.get_edges()) {
+    const bool initialization = edge.color == Edge::Color::Gray;
+    if (initialization) {
+      graph.add_vertex();
+    }
+    graph.connect_vertices(edge.connected_vertices[0],
+                           edge.connected_vertices[1], initialization);
+  }
+}
+
+// Returns the allocations per graph
+template <typename Callback>
+double report(const std::string& name, const Callback& run) {
+  const auto allocations_before = allocations_count.load();
+  const auto timer = Timer();
+  run();
+  const double elapsed_ms = timer.elapsed_ms();
+  const double allocations = allocations_count.load() - allocations_before;
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(16) << std::fixed << std::setprecision(1)
+            << allocations / GRAPHS_COUNT << std::setw(14)
+            << elapsed_ms * 1000 / GRAPHS_COUNT << std::endl;
+  return allocations / GRAPHS_COUNT;
+}
+
+bool check_steady(const std::string& name, double allocations_per_graph) {
+  if (allocations_per_graph <= MAX_STEADY_ALLOCATIONS_PER_GRAPH)
+    return true;
+  std::cout << "  FAILED: " << name << " makes " << allocations_per_graph
+            << " allocations per graph, expected at most "
+            << MAX_STEADY_ALLOCATIONS_PER_GRAPH << std::endl;
+  return false;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations_count++;
+  if (void* pointer = std::malloc(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+int main() {
+  const auto params = GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM, SEED);
+  const auto generator = GraphGenerator(params);
+  const auto reference = generator.generate();
+  std::cout << "reference graph: " << reference.get_vertices_num()
+            << " vertices, " << reference.get_edges_num() << " edges"
+            << std::endl;
+  std::cout << std::setw(28) << std::left << "benchmark" << std::right
+            << std::setw(16) << "allocs/graph" << std::setw(14) << "us/graph"
+            << std::endl;
+
+  report("replay, new graph", [&reference]() {
+    for (int i = 0; i < GRAPHS_COUNT; i++) {
+      auto graph = Graph();
+      replay_graph(reference, graph);
+    }
+  });
+  auto pooled_graph = Graph();
+  replay_graph(reference, pooled_graph);
+  report("replay, reset graph", [&reference, &pooled_graph]() {
+    for (int i = 0; i < GRAPHS_COUNT; i++) {
+      pooled_graph.reset();
+      replay_graph(reference, pooled_graph);
+    }
+  });
+
+  report("generate, new graph", [&generator]() {
+    for (int i = 0; i < GRAPHS_COUNT; i++) {
+      const auto graph = generator.generate();
+    }
+  });
+  const auto generate_reset = [&generator, &pooled_graph]() {
+    for (int i = 0; i < GRAPHS_COUNT; i++) {
+      pooled_graph.reset();
+      generator.generate(pooled_graph, i);
+    }
+  };
+  // The first batch grows the pooled graph and the threads' scratch storage
+  generate_reset();
+  const bool is_generate_steady = check_steady(
+      "generate", report("generate, reset graph", generate_reset));
+
+  auto controller = GraphGenerationController(1, GRAPHS_COUNT, params);
+  const auto generate_batch = [&controller]() {
+    controller.generate([](int) {}, [](const Graph&, int) {});
+  };
+  generate_batch();
+  const bool is_controller_steady = check_steady(
+      "controller", report("controller, pooled graphs", generate_batch));
+  return is_generate_steady && is_controller_steady ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "../roman_kuprii/graph_reading.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int VERTICES_NUM = 200000;
+constexpr int CHILDREN_NUM = 4;
+
+const std::string JSON_FILENAME = "roman_kuprii_json_load.json";
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::VertexId;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+namespace dom {
+
+// A generic JSON document, parsed the usual way: every value is a node
+// with its own allocations
+
+struct Value {
+  enum class Type { Null, Bool, Number, String, Array, Object };
+
+  Type type = Type::Null;
+  bool boolean = false;
+  double number = 0;
+  std::string string;
+  std::vector<Value> array;
+  std::vector<std::pair<std::string, Value>> object;
+
+  const Value& at(const std::string& key) const {
+    for (const auto& [name, value] : object)
+      if (name == key)
+        return value;
+    throw std::runtime_error("no key " + key);
+  }
+};
+
+class Parser {
+ public:
+  explicit Parser(const std::string& json) : json_(json) {}
+
+  Value parse() {
+    auto value = parse_value();
+    skip_whitespace();
+    if (position_ != json_.size())
+      throw std::runtime_error("trailing characters");
+    return value;
+  }
+
+ private:
+  const std::string& json_;
+  std::size_t position_ = 0;
+
+  Value parse_value() {
+    skip_whitespace();
+    Value value;
+    const char symbol = json_.at(position_);
+    if (symbol == '{') {
+      value.type = Value::Type::Object;
+      ++position_;
+      if (!try_consume('}')) {
+        do {
+          skip_whitespace();
+          auto key = parse_string();
+          expect(':');
+          value.object.emplace_back(std::move(key), parse_value());
+        } while (try_consume(','));
+        expect('}');
+      }
+    } else if (symbol == '[') {
+      value.type = Value::Type::Array;
+      ++position_;
+      if (!try_consume(']')) {
+        do {
+          value.array.push_back(parse_value());
+        } while (try_consume(','));
+        expect(']');
+      }
+    } else if (symbol == '"') {
+      value.type = Value::Type::String;
+      value.string = parse_string();
+    } else if (json_.compare(position_, 4, "true") == 0 ||
+               json_.compare(position_, 5, "false") == 0) {
+      value.type = Value::Type::Bool;
+      value.boolean = symbol == 't';
+      position_ += value.boolean ? 4 : 5;
+    } else if (json_.compare(position_, 4, "null") == 0) {
+      position_ += 4;
+    } else {
+      value.type = Value::Type::Number;
+      char* end = nullptr;
+      value.number = std::strtod(json_.c_str() + position_, &end);
+      if (end == json_.c_str() + position_)
+        throw std::runtime_error("unexpected character");
+      position_ = end - json_.c_str();
+    }
+    return value;
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string string;
+    while (json_.at(position_) != '"') {
+      if (json_[position_] == '\\')
+        ++position_;
+      string += json_.at(position_++);
+    }
+    ++position_;
+    return string;
+  }
+
+  void expect(char symbol) {
+    if (!try_consume(symbol))
+      throw std::runtime_error(std::string("expected ") + symbol);
+  }
+
+  bool try_consume(char symbol) {
+    skip_whitespace();
+    if (position_ < json_.size() && json_[position_] == symbol) {
+      ++position_;
+      return true;
+    }
+    return false;
+  }
+
+  void skip_whitespace() {
+    while (position_ < json_.size() &&
+           (json_[position_] == ' ' || json_[position_] == '\n' ||
+            json_[position_] == '\t' || json_[position_] == '\r'))
+      ++position_;
+  }
+};
+
+Edge::Color color_from_string(const std::string& color) {
+  if (color == "green")
+    return Edge::Color::Green;
+  if (color == "blue")
+    return Edge::Color::Blue;
+  if (color == "yellow")
+    return Edge::Color::Yellow;
+  if (color == "red")
+    return Edge::Color::Red;
+  return Edge::Color::Gray;
+}
+
+// Same result as graph_reading::graph_from_json(), without its checks
+Graph to_graph(const Value& document) {
+  const auto& vertices = document.at("vertices").array;
+  const auto& edges = document.at("edges").array;
+  std::vector<int> depths(vertices.size(), 0);
+  for (const auto& edge : edges) {
+    const auto& vertex_ids = edge.at("vertex_ids").array;
+    const int to_vertex_id = vertex_ids[1].number;
+    if (to_vertex_id != 0 && depths[to_vertex_id] == 0 &&
+        edge.at("color").string == "gray")
+      depths[to_vertex_id] = depths[static_cast<int>(vertex_ids[0].number)] + 1;
+  }
+
+  Graph graph;
+  graph.reserve(vertices.size(), edges.size());
+  for (const auto& depth : depths)
+    graph.restore_vertex(depth);
+  for (const auto& edge : edges) {
+    const auto& vertex_ids = edge.at("vertex_ids").array;
+    graph.restore_edge(vertex_ids[0].number, vertex_ids[1].number,
+                       color_from_string(edge.at("color").string));
+  }
+  return graph;
+}
+
+}  // namespace dom
+
+Graph make_graph() {
+  Graph graph;
+  graph.reserve(VERTICES_NUM, 2 * VERTICES_NUM);
+  std::vector<int> depths = {0};
+  graph.restore_vertex(0);
+  for (VertexId vertex_id = 1; vertex_id < VERTICES_NUM; ++vertex_id) {
+    depths.push_back(depths[(vertex_id - 1) / CHILDREN_NUM] + 1);
+    graph.restore_vertex(depths.back());
+  }
+  for (VertexId vertex_id = 1; vertex_id < VERTICES_NUM; ++vertex_id)
+    graph.restore_edge((vertex_id - 1) / CHILDREN_NUM, vertex_id,
+                       Edge::Color::Gray);
+  for (VertexId vertex_id = 2; vertex_id < VERTICES_NUM; ++vertex_id)
+    if (depths[vertex_id - 1] == depths[vertex_id])
+      graph.restore_edge(vertex_id - 1, vertex_id, Edge::Color::Blue);
+  return graph;
+}
+
+void report(const std::string& name, std::size_t bytes, double elapsed_ms) {
+  std::cout << std::setw(32) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << elapsed_ms << std::setw(12) << bytes / elapsed_ms / 1000
+            << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  const auto json =
+      uni_cpp_practice::graph_printing::graph_to_json(make_graph());
+  std::ofstream(JSON_FILENAME) << json;
+  std::cout << "graph JSON: " << json.size() << " bytes" << std::endl;
+
+  if (uni_cpp_practice::graph_printing::graph_to_json(
+          uni_cpp_practice::graph_reading::read_graph_json(JSON_FILENAME)) !=
+          json ||
+      uni_cpp_practice::graph_printing::graph_to_json(
+          dom::to_graph(dom::Parser(json).parse())) != json) {
+    std::cerr << "Loaded graph differs from the original" << std::endl;
+    return 1;
+  }
+
+  std::cout << std::setw(32) << std::left << "loader" << std::right
+            << std::setw(12) << "ms" << std::setw(12) << "MB/s" << std::endl;
+  long long sink = 0;
+  report("DOM parse", json.size(), median_time_ms(REPEATS, [&json, &sink]() {
+           sink += dom::Parser(json).parse().object.size();
+         }));
+  report("DOM parse + to_graph", json.size(),
+         median_time_ms(REPEATS, [&json, &sink]() {
+           sink += dom::to_graph(dom::Parser(json).parse()).get_edges_num();
+         }));
+  report("graph_from_json", json.size(),
+         median_time_ms(REPEATS, [&json, &sink]() {
+           sink += uni_cpp_practice::graph_reading::graph_from_json(json)
+                       .get_edges_num();
+         }));
+  report("read_graph_json (streaming)", json.size(),
+         median_time_ms(REPEATS, [&sink]() {
+           sink += uni_cpp_practice::graph_reading::read_graph_json(
+                       JSON_FILENAME)
+                       .get_edges_num();
+         }));
+
+  std::remove(JSON_FILENAME.c_str());
+  return sink == 0;
+}
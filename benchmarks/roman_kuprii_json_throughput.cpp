@@ -0,0 +1,160 @@
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 21;
+constexpr int DEPTH = 6;
+constexpr int NEW_VERTICES_NUM = 5;
+
+const std::string JSON_FILENAME = "roman_kuprii_json_throughput.json";
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::Vertex;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+namespace graph_printing = uni_cpp_practice::graph_printing;
+
+namespace legacy {
+
+// The serializer as it was before write_graph_json(): std::to_string and a
+// temporary string per vertex and edge
+
+using std::to_string;
+using uni_cpp_practice::graph_printing::color_to_string;
+
+std::string edge_to_json(const Edge& edge) {
+  std::string res;
+  res = "{ \"id\": ";
+  res += to_string(edge.id);
+  res += ", \"vertex_ids\": [";
+  res += to_string(edge.connected_vertices[0]);
+  res += ", ";
+  res += to_string(edge.connected_vertices[1]);
+  res += "], \"color\": ";
+  res += color_to_string(edge.color);
+  res += " }";
+  return res;
+}
+
+std::string vertex_to_json(const Vertex& vertex) {
+  std::string res;
+  res = "{ \"id\": ";
+  res += to_string(vertex.get_id()) + ", \"edge_ids\": [";
+  for (const auto& edge_id : vertex.get_edges_ids()) {
+    res += to_string(edge_id);
+    res += ", ";
+  }
+  if (vertex.get_edges_ids().size() > 0) {
+    res.pop_back();
+    res.pop_back();
+  }
+  res += "] }";
+  return res;
+}
+
+std::string graph_to_json(const Graph& graph) {
+  std::string res;
+  res = "{ \"depth\": ";
+  res += to_string(graph.get_depth());
+  res += ", \"vertices\": [ ";
+  for (const auto& vertex : graph.get_vertices()) {
+    res += vertex_to_json(vertex);
+    res += ", ";
+  }
+  if (graph.get_vertices().size()) {
+    res.pop_back();
+    res.pop_back();
+  }
+  res += " ], \"edges\": [ ";
+  for (const auto& edge : graph.get_edges()) {
+    res += edge_to_json(edge);
+    res += ", ";
+  }
+  if (graph.get_edges().size() > 0) {
+    res.pop_back();
+    res.pop_back();
+  }
+  res += " ] }\n";
+  return res;
+}
+
+}  // namespace legacy
+
+std::string read_file(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+void report(const std::string& name, std::size_t bytes, double elapsed_ms) {
+  std::cout << std::setw(32) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3)
+            << elapsed_ms << std::setw(12) << std::setprecision(1)
+            << bytes / elapsed_ms / 1000 << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  const auto generator =
+      GraphGenerator(GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM));
+  const auto graph = generator.generate();
+
+  const auto expected = legacy::graph_to_json(graph);
+  std::string buffer;
+  graph_printing::write_graph_json(graph, buffer);
+  graph_printing::write_graph_json_mapped(graph, JSON_FILENAME);
+  if (buffer != expected || graph_printing::graph_json_size(graph) !=
+                                expected.size() ||
+      read_file(JSON_FILENAME) != expected) {
+    std::cerr << "write_graph_json() output differs from the legacy one"
+              << std::endl;
+    return 1;
+  }
+  std::cout << "graph: " << graph.get_vertices_num() << " vertices, "
+            << graph.get_edges_num() << " edges, " << expected.size()
+            << " bytes of JSON" << std::endl;
+  std::cout << std::setw(32) << std::left << "serializer" << std::right
+            << std::setw(12) << "ms" << std::setw(12) << "MB/s" << std::endl;
+
+  std::size_t sink = 0;
+  report("legacy graph_to_json", expected.size(),
+         median_time_ms(REPEATS, [&graph, &sink]() {
+           sink += legacy::graph_to_json(graph).size();
+         }));
+  report("graph_to_json", expected.size(),
+         median_time_ms(REPEATS, [&graph, &sink]() {
+           sink += graph_printing::graph_to_json(graph).size();
+         }));
+  report("write_graph_json reused", expected.size(),
+         median_time_ms(REPEATS, [&graph, &buffer, &sink]() {
+           buffer.clear();
+           graph_printing::write_graph_json(graph, buffer);
+           sink += buffer.size();
+         }));
+  report("file: ofstream", expected.size(),
+         median_time_ms(REPEATS, [&graph, &sink]() {
+           const auto json = graph_printing::graph_to_json(graph);
+           std::ofstream(JSON_FILENAME).write(json.data(), json.size());
+           sink += json.size();
+         }));
+  report("file: write_graph_json_mapped", expected.size(),
+         median_time_ms(REPEATS, [&graph, &sink]() {
+           graph_printing::write_graph_json_mapped(graph, JSON_FILENAME);
+           ++sink;
+         }));
+
+  std::remove(JSON_FILENAME.c_str());
+  return sink == 0;
+}
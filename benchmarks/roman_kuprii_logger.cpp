@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../roman_kuprii/logger.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int MESSAGES_PER_THREAD = 20000;
+// Fits the ring with every thread count, so nobody waits for the console
+constexpr int BURST_MESSAGES_NUM = 1000;
+const std::vector<int> THREADS_COUNTS = {1, 2, 4};
+
+// What the console would get, kept out of the terminal
+const std::string CONSOLE_FILENAME = "roman_kuprii_logger.console";
+const std::string LOG_FILENAME = "roman_kuprii_logger.log";
+
+using uni_cpp_practice::Logger;
+using uni_cpp_practice::benchmark::Timer;
+
+// About the size of a write_log_end() message
+const std::string MESSAGE =
+    "2024.01.01 00:00:00: Graph 1, Generation Ended {\n"
+    "  depth: 5,\n"
+    "  vertices: 744, [1, 3, 10, 38, 143, 549],\n"
+    "  edges: 1458, {gray: 743, green: 701, blue: 5, yellow: 6, red: 3},\n"
+    "  memory: 68120 bytes, {vertices: 29760, edges: 35000, adjacency: 0, "
+    "depth_index: 3000, color_index: 360}\n"
+    "}\n";
+
+// What Logger::log() did: formats and flushes on the calling thread,
+// serialized by a mutex as tevfik_aksoy's logger does
+class SyncLogger {
+ public:
+  explicit SyncLogger(const std::string& filename) : file_stream_(filename) {}
+
+  void log(const std::string& text) {
+    const std::lock_guard lock(mutex_);
+    std::cout << text << std::endl;
+    file_stream_ << text << std::endl;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::ofstream file_stream_;
+};
+
+// Mean time of a log call on the worker threads in nanoseconds
+template <typename Log>
+double run_workers(int threads_count, int messages_num, const Log& log) {
+  std::vector<double> thread_times(threads_count);
+  std::vector<std::thread> threads;
+  for (int thread_id = 0; thread_id < threads_count; ++thread_id)
+    threads.emplace_back([&log, &thread_times, thread_id, messages_num]() {
+      const auto timer = Timer();
+      for (int i = 0; i < messages_num; ++i)
+        log(MESSAGE);
+      thread_times[thread_id] = timer.elapsed_ms();
+    });
+  for (auto& thread : threads)
+    thread.join();
+
+  double total_ms = 0;
+  for (const double thread_ms : thread_times)
+    total_ms += thread_ms;
+  return total_ms * 1e6 / (threads_count * messages_num);
+}
+
+template <typename Callback>
+double median(const Callback& run) {
+  std::vector<double> values;
+  for (int i = 0; i < REPEATS; ++i)
+    values.push_back(run());
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+int count_messages(const std::string& filename) {
+  std::ifstream file(filename);
+  const auto text = std::string(std::istreambuf_iterator<char>(file), {});
+  int messages_count = 0;
+  for (auto position = text.find(MESSAGE); position != std::string::npos;
+       position = text.find(MESSAGE, position + MESSAGE.size()))
+    ++messages_count;
+  return messages_count;
+}
+
+}  // namespace
+
+int main() {
+  auto console = std::ofstream(CONSOLE_FILENAME);
+  auto* const stdout_buffer = std::cout.rdbuf(console.rdbuf());
+
+  auto& logger = Logger::get_logger();
+  std::vector<std::vector<double>> results;
+  for (const int threads_count : THREADS_COUNTS) {
+    const double sync_ns = median([threads_count]() {
+      auto sync_logger = SyncLogger(LOG_FILENAME);
+      return run_workers(threads_count, MESSAGES_PER_THREAD,
+                         [&sync_logger](const auto& text) {
+                           sync_logger.log(text);
+                         });
+    });
+
+    logger.set_overflow_policy(Logger::OverflowPolicy::Block);
+    const double burst_ns = median([threads_count, &logger]() {
+      logger.set_output(LOG_FILENAME);
+      const double ns = run_workers(
+          threads_count, BURST_MESSAGES_NUM / threads_count,
+          [&logger](const auto& text) { logger.log(text); });
+      logger.flush();
+      return ns;
+    });
+    const double block_ns = median([threads_count, &logger]() {
+      logger.set_output(LOG_FILENAME);
+      const double ns = run_workers(
+          threads_count, MESSAGES_PER_THREAD,
+          [&logger](const auto& text) { logger.log(text); });
+      logger.flush();
+      return ns;
+    });
+    // Every message of the last run has to reach the file when blocking
+    logger.set_output(std::nullopt);
+    if (count_messages(LOG_FILENAME) != threads_count * MESSAGES_PER_THREAD) {
+      std::cout.rdbuf(stdout_buffer);
+      std::cerr << "Logger lost messages" << std::endl;
+      return 1;
+    }
+
+    logger.set_overflow_policy(Logger::OverflowPolicy::Drop);
+    const auto dropped_before = logger.get_dropped_count();
+    const double drop_ns = median([threads_count, &logger]() {
+      logger.set_output(LOG_FILENAME);
+      const double ns = run_workers(
+          threads_count, MESSAGES_PER_THREAD,
+          [&logger](const auto& text) { logger.log(text); });
+      logger.flush();
+      return ns;
+    });
+    const double dropped_share =
+        static_cast<double>(logger.get_dropped_count() - dropped_before) /
+        (REPEATS * threads_count * MESSAGES_PER_THREAD);
+    results.push_back({static_cast<double>(threads_count), sync_ns, burst_ns,
+                       block_ns, drop_ns, dropped_share * 100});
+  }
+  logger.set_output(std::nullopt);
+  std::cout.rdbuf(stdout_buffer);
+
+  std::cout << MESSAGES_PER_THREAD << " messages of " << MESSAGE.size()
+            << " bytes per thread, ns per log call" << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(12) << "sync"
+            << std::setw(12) << "burst" << std::setw(12) << "block"
+            << std::setw(12) << "drop"
+            << std::setw(12) << "dropped %" << std::endl;
+  for (const auto& row : results) {
+    std::cout << std::setw(8) << static_cast<int>(row[0]) << std::fixed
+              << std::setprecision(1);
+    for (std::size_t column = 1; column < row.size(); ++column)
+      std::cout << std::setw(12) << row[column];
+    std::cout << std::endl;
+  }
+
+  std::remove(CONSOLE_FILENAME.c_str());
+  std::remove(LOG_FILENAME.c_str());
+  return 0;
+}
@@ -0,0 +1,138 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/graph_generator.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "../roman_kuprii/output_writer.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int GRAPHS_NUM = 2000;
+constexpr int DISTINCT_GRAPHS_NUM = 50;
+constexpr int DEPTH = 4;
+constexpr int NEW_VERTICES_NUM = 4;
+
+const std::string FILENAME = "roman_kuprii_output_writer.out";
+
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::OutputWriter;
+using uni_cpp_practice::benchmark::Timer;
+
+struct Times {
+  double total_ms = 0;
+  // Spent by the producer waiting for the output
+  double blocked_ms = 0;
+};
+
+// What write_graph() did: the producer writes every graph itself
+Times write_sync(const std::vector<std::string>& jsons, bool should_sync) {
+  const auto total_timer = Timer();
+  const int file_descriptor =
+      ::open(FILENAME.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  for (int graph_id = 0; graph_id < GRAPHS_NUM; ++graph_id) {
+    const auto& json = jsons[graph_id % jsons.size()];
+    if (::write(file_descriptor, json.data(), json.size()) == -1 ||
+        (should_sync && ::fdatasync(file_descriptor) == -1))
+      std::cerr << "Failed to write " << FILENAME << std::endl;
+  }
+  ::close(file_descriptor);
+  const double total_ms = total_timer.elapsed_ms();
+  return {total_ms, total_ms};
+}
+
+Times write_async(const std::vector<std::string>& jsons,
+                  OutputWriter::FsyncPolicy fsync_policy) {
+  const auto total_timer = Timer();
+  const int file_descriptor =
+      ::open(FILENAME.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  OutputWriter::Options options;
+  options.buffer_size = 64 << 10;
+  options.fsync_policy = fsync_policy;
+  double blocked_ms = 0;
+  {
+    auto writer = OutputWriter(file_descriptor, FILENAME, options);
+    for (int graph_id = 0; graph_id < GRAPHS_NUM; ++graph_id) {
+      const auto submit_timer = Timer();
+      writer.submit(jsons[graph_id % jsons.size()]);
+      blocked_ms += submit_timer.elapsed_ms();
+    }
+    writer.close();
+  }
+  ::close(file_descriptor);
+  return {total_timer.elapsed_ms(), blocked_ms};
+}
+
+template <typename Callback>
+Times median_times(const Callback& run) {
+  std::vector<Times> times;
+  for (int i = 0; i < REPEATS; ++i)
+    times.push_back(run());
+  std::sort(times.begin(), times.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.total_ms < rhs.total_ms;
+  });
+  return times[times.size() / 2];
+}
+
+void report(const std::string& name, const Times& times) {
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << times.total_ms << std::setw(12) << times.blocked_ms
+            << std::endl;
+}
+
+std::string read_file(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+}  // namespace
+
+int main() {
+  const auto generator =
+      GraphGenerator(GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM));
+  std::vector<std::string> jsons;
+  std::string expected;
+  for (int i = 0; i < DISTINCT_GRAPHS_NUM; ++i)
+    jsons.push_back(uni_cpp_practice::graph_printing::graph_to_json(
+        generator.generate()));
+  for (int graph_id = 0; graph_id < GRAPHS_NUM; ++graph_id)
+    expected += jsons[graph_id % jsons.size()];
+
+  write_async(jsons, OutputWriter::FsyncPolicy::Never);
+  if (read_file(FILENAME) != expected) {
+    std::cerr << "Written file differs from the submitted data" << std::endl;
+    return 1;
+  }
+
+  std::cout << GRAPHS_NUM << " graphs, " << expected.size() << " bytes"
+            << std::endl;
+  std::cout << std::setw(28) << std::left << "writer" << std::right
+            << std::setw(12) << "total ms" << std::setw(12) << "blocked ms"
+            << std::endl;
+  report("write", median_times([&jsons]() {
+           return write_sync(jsons, false);
+         }));
+  report("write + fdatasync", median_times([&jsons]() {
+           return write_sync(jsons, true);
+         }));
+  report("OutputWriter, sync on close", median_times([&jsons]() {
+           return write_async(jsons, OutputWriter::FsyncPolicy::OnClose);
+         }));
+  report("OutputWriter, sync buffers", median_times([&jsons]() {
+           return write_async(jsons, OutputWriter::FsyncPolicy::EveryBuffer);
+         }));
+
+  std::remove(FILENAME.c_str());
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_printing.hpp"
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr int REPEATS = 5;
+constexpr int VERTICES_NUM = 1 << 20;
+constexpr int CHILDREN_NUM = 4;
+const std::vector<int> THREADS_COUNTS = {1, 2, 4, 8, 16};
+
+const std::string JSON_FILENAME = "roman_kuprii_parallel_json.json";
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::VertexId;
+using uni_cpp_practice::benchmark::median_time_ms;
+
+namespace graph_printing = uni_cpp_practice::graph_printing;
+
+// The generator is too slow for graphs of this size, so build a complete
+// tree with blue edges between neighbours on a level instead
+Graph make_graph() {
+  Graph graph;
+  graph.reserve(VERTICES_NUM, 2 * VERTICES_NUM);
+  std::vector<int> depths = {0};
+  graph.restore_vertex(0);
+  for (VertexId vertex_id = 1; vertex_id < VERTICES_NUM; ++vertex_id) {
+    depths.push_back(depths[(vertex_id - 1) / CHILDREN_NUM] + 1);
+    graph.restore_vertex(depths.back());
+  }
+  for (VertexId vertex_id = 1; vertex_id < VERTICES_NUM; ++vertex_id)
+    graph.restore_edge((vertex_id - 1) / CHILDREN_NUM, vertex_id,
+                       Edge::Color::Gray);
+  for (VertexId vertex_id = 2; vertex_id < VERTICES_NUM; ++vertex_id)
+    if (depths[vertex_id - 1] == depths[vertex_id])
+      graph.restore_edge(vertex_id - 1, vertex_id, Edge::Color::Blue);
+  return graph;
+}
+
+std::string read_file(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+}  // namespace
+
+int main() {
+  const auto graph = make_graph();
+  const auto json = graph_printing::graph_to_json(graph);
+  std::cout << "graph JSON: " << json.size() << " bytes" << std::endl;
+
+  for (const auto& threads_count : THREADS_COUNTS) {
+    graph_printing::write_graph_json_file(graph, JSON_FILENAME, threads_count);
+    if (read_file(JSON_FILENAME) != json) {
+      std::cerr << "Output of " << threads_count
+                << " threads differs from graph_to_json()" << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << std::setw(10) << "threads" << std::setw(12) << "ms"
+            << std::setw(12) << "MB/s" << std::setw(12) << "speedup"
+            << std::endl;
+  double single_thread_ms = 0;
+  for (const auto& threads_count : THREADS_COUNTS) {
+    const auto elapsed_ms = median_time_ms(REPEATS, [&graph, threads_count]() {
+      graph_printing::write_graph_json_file(graph, JSON_FILENAME,
+                                            threads_count);
+    });
+    if (threads_count == 1)
+      single_thread_ms = elapsed_ms;
+    std::cout << std::setw(10) << threads_count << std::setw(12) << std::fixed
+              << std::setprecision(1) << elapsed_ms << std::setw(12)
+              << json.size() / elapsed_ms / 1000 << std::setw(12)
+              << std::setprecision(2) << single_thread_ms / elapsed_ms
+              << std::endl;
+  }
+
+  std::remove(JSON_FILENAME.c_str());
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generation_controller.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+
+namespace {
+
+constexpr int REPEATS = 3;
+constexpr int DEPTH = 5;
+constexpr int NEW_VERTICES_NUM = 3;
+// Graph i of every run is generated from SEED + i, so the runs of a mode
+// generate the same gray trees whatever the threads count
+constexpr std::uint64_t SEED = 2021;
+// Strong scaling splits a fixed batch between the threads, weak scaling
+// gives every thread the same number of graphs
+constexpr int STRONG_GRAPHS_COUNT = 64;
+constexpr int WEAK_GRAPHS_PER_THREAD = 16;
+
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::graph_generation_controller::GraphGenerationController;
+
+struct Run {
+  double seconds = 0;
+  // Of the workers' time, what they spent polling the job queue
+  double idle_fraction = 0;
+};
+
+// The run with the median wall time
+Run measure(int threads_count, int graphs_count) {
+  const auto params = GraphGenerator::Params(DEPTH, NEW_VERTICES_NUM, SEED);
+  std::vector<Run> runs;
+  for (int i = 0; i < REPEATS; ++i) {
+    auto controller =
+        GraphGenerationController(threads_count, graphs_count, params);
+    controller.generate([](int) {}, [](const Graph&, int) {});
+    const double seconds =
+        std::chrono::duration<double>(controller.get_generate_time()).count();
+    const double jobs_seconds =
+        std::chrono::duration<double>(controller.get_jobs_time()).count();
+    const double workers_seconds = seconds * controller.get_threads_count();
+    runs.push_back({seconds, 1 - jobs_seconds / workers_seconds});
+  }
+  std::sort(runs.begin(), runs.end(), [](const Run& left, const Run& right) {
+    return left.seconds < right.seconds;
+  });
+  return runs[runs.size() / 2];
+}
+
+// Speedup is the throughput relative to one thread: for fixed work that's
+// the time ratio, for weak scaling the ideal is a flat time
+void run_scaling(const std::string& name,
+                 int max_threads_count,
+                 int (*get_graphs_count)(int threads_count)) {
+  std::cout << std::endl << name << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(8) << "graphs"
+            << std::setw(12) << "seconds" << std::setw(12) << "graphs/s"
+            << std::setw(10) << "speedup" << std::setw(12) << "efficiency"
+            << std::setw(8) << "idle" << std::endl;
+  double single_thread_throughput = 0;
+  for (int threads_count = 1; threads_count <= max_threads_count;
+       ++threads_count) {
+    const int graphs_count = get_graphs_count(threads_count);
+    const auto run = measure(threads_count, graphs_count);
+    const double throughput = graphs_count / run.seconds;
+    if (threads_count == 1)
+      single_thread_throughput = throughput;
+    const double speedup = throughput / single_thread_throughput;
+    std::cout << std::setw(8) << threads_count << std::setw(8) << graphs_count
+              << std::fixed << std::setprecision(3) << std::setw(12)
+              << run.seconds << std::setprecision(1) << std::setw(12)
+              << throughput << std::setprecision(2) << std::setw(10)
+              << speedup << std::setw(12) << speedup / threads_count
+              << std::setprecision(0) << std::setw(7)
+              << run.idle_fraction * 100 << '%' << std::endl;
+  }
+}
+
+}  // namespace
+
+// Sweeps the controller's threads from 1 to `max_threads_count`, by default
+// std::thread::hardware_concurrency()
+int main(int argc, char** argv) {
+  const int max_threads_count =
+      argc > 1 ? std::atoi(argv[1])
+               : std::max<int>(std::thread::hardware_concurrency(), 1);
+  if (max_threads_count < 1) {
+    std::cerr << "Usage: roman_kuprii_scaling [max_threads_count]"
+              << std::endl;
+    return 1;
+  }
+  std::cout << "depth " << DEPTH << ", new_vertices_num " << NEW_VERTICES_NUM
+            << ", seed " << SEED << ", median of " << REPEATS << " runs"
+            << std::endl;
+  run_scaling("strong scaling", max_threads_count,
+              [](int) { return STRONG_GRAPHS_COUNT; });
+  run_scaling("weak scaling", max_threads_count, [](int threads_count) {
+    return WEAK_GRAPHS_PER_THREAD * threads_count;
+  });
+  return 0;
+}
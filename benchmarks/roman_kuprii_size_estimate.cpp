@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../roman_kuprii/graph.hpp"
+#include "../roman_kuprii/graph_generator.hpp"
+
+namespace {
+
+constexpr int GRAPHS_COUNT = 100;
+// Graph i of every params is generated from SEED + i, so the check is
+// repeatable
+constexpr std::uint64_t SEED = 2021;
+// The check fails if the mean vertices or edges count is off the estimate
+// by more than MEAN_TOLERANCE of the estimate, or if fewer than
+// MIN_QUANTILE_COVERAGE of the graphs fit in the ~99% quantiles. The
+// per-color counts are only printed: they are small and noisy.
+constexpr double MEAN_TOLERANCE = 0.1;
+constexpr double MIN_QUANTILE_COVERAGE = 0.95;
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::GraphGenerator;
+
+const std::array<std::string, 5> COLOR_NAMES = {"gray", "green", "blue",
+                                                "yellow", "red"};
+
+void print_row(const std::string& name,
+               double predicted,
+               double actual,
+               const std::string& extra = "") {
+  std::cout << "  " << std::setw(16) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1) << predicted
+            << std::setw(12) << actual << std::setw(9)
+            << (actual - predicted) / std::max(actual, 1.0) * 100 << "%"
+            << extra << std::endl;
+}
+
+bool check_mean(const std::string& name, double predicted, double actual) {
+  if (std::abs(actual - predicted) <= MEAN_TOLERANCE * predicted)
+    return true;
+  std::cout << "  FAILED: mean " << name << " " << actual
+            << " is off the estimate " << predicted << " by more than "
+            << MEAN_TOLERANCE * 100 << "%" << std::endl;
+  return false;
+}
+
+bool check_coverage(const std::string& name, int quantile, int within_count) {
+  if (within_count >= MIN_QUANTILE_COVERAGE * GRAPHS_COUNT)
+    return true;
+  std::cout << "  FAILED: " << within_count << "/" << GRAPHS_COUNT
+            << " graphs have " << name << " <= " << quantile << ", expected "
+            << MIN_QUANTILE_COVERAGE * 100 << "%" << std::endl;
+  return false;
+}
+
+// Prints predicted and actual sizes, returns whether they agree
+bool compare(const GraphGenerator::Params& params) {
+  const auto generator = GraphGenerator(params);
+  const auto& estimate = generator.get_size_estimate();
+
+  double vertices = 0;
+  double edges = 0;
+  std::array<double, 5> edges_per_color = {};
+  int vertices_within_quantile = 0;
+  int edges_within_quantile = 0;
+  auto graph = Graph();
+  for (int i = 0; i < GRAPHS_COUNT; i++) {
+    graph.reset();
+    generator.generate(graph, i);
+    vertices += graph.get_vertices_num();
+    edges += graph.get_edges_num();
+    for (const auto& edge : graph.get_edges())
+      edges_per_color[static_cast<int>(edge.color)]++;
+    vertices_within_quantile +=
+        graph.get_vertices_num() <= estimate.vertices_quantile;
+    edges_within_quantile += graph.get_edges_num() <= estimate.edges_quantile;
+  }
+
+  std::cout << "depth " << params.depth << ", new_vertices_num "
+            << params.new_vertices_num << ", " << GRAPHS_COUNT << " graphs"
+            << std::endl;
+  std::cout << "  " << std::setw(16) << std::left << "" << std::right
+            << std::setw(12) << "predicted" << std::setw(12) << "actual"
+            << std::setw(10) << "error" << std::endl;
+  print_row("vertices", estimate.vertices, vertices / GRAPHS_COUNT);
+  print_row("edges", estimate.edges, edges / GRAPHS_COUNT);
+  for (int color = 0; color < static_cast<int>(COLOR_NAMES.size()); color++)
+    print_row("  " + COLOR_NAMES[color], estimate.edges_per_color[color],
+              edges_per_color[color] / GRAPHS_COUNT);
+  std::cout << "  vertices <= " << estimate.vertices_quantile << ": "
+            << vertices_within_quantile << "/" << GRAPHS_COUNT
+            << ", edges <= " << estimate.edges_quantile << ": "
+            << edges_within_quantile << "/" << GRAPHS_COUNT << std::endl;
+
+  // Not short-circuited, every failure is printed
+  const bool is_vertices_mean_ok =
+      check_mean("vertices", estimate.vertices, vertices / GRAPHS_COUNT);
+  const bool is_edges_mean_ok =
+      check_mean("edges", estimate.edges, edges / GRAPHS_COUNT);
+  const bool is_vertices_coverage_ok = check_coverage(
+      "vertices", estimate.vertices_quantile, vertices_within_quantile);
+  const bool is_edges_coverage_ok = check_coverage(
+      "edges", estimate.edges_quantile, edges_within_quantile);
+  return is_vertices_mean_ok && is_edges_mean_ok && is_vertices_coverage_ok &&
+         is_edges_coverage_ok;
+}
+
+}  // namespace
+
+// Exits with 1 if an estimate is off, see MEAN_TOLERANCE and
+// MIN_QUANTILE_COVERAGE
+int main() {
+  const std::vector<GraphGenerator::Params> params_list = {
+      {3, 3, SEED}, {4, 4, SEED}, {6, 3, SEED}, {5, 6, SEED}};
+  bool is_ok = true;
+  for (const auto& params : params_list)
+    is_ok = compare(params) && is_ok;
+  return is_ok ? 0 : 1;
+}
@@ -1,11 +1,32 @@
 #include "graph_printer.hpp"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <iostream>
+#include <random>
+#include <string_view>
+#include <unordered_set>
 
 using Color = Edge::Color;
 
 namespace {
-std::string edge_color_to_string(const Color& color) {
+// enough for any 64-bit integer
+constexpr int MAX_NUMBER_LENGTH = 20;
+
+constexpr std::array<Color, 4> COLORS = {Color::Grey, Color::Green,
+                                         Color::Yellow, Color::Red};
+
+template <typename Number>
+void append_number(std::string& buffer, Number number) {
+  std::array<char, MAX_NUMBER_LENGTH> digits;
+  const auto result =
+      std::to_chars(digits.data(), digits.data() + digits.size(), number);
+  buffer.append(digits.data(), result.ptr);
+}
+
+std::string_view edge_color_to_string(const Color& color) {
   switch (color) {
     case Color::Grey:
       return "\"gray\"\n\t  }";
@@ -17,53 +38,238 @@ std::string edge_color_to_string(const Color& color) {
       return "\"red\"\n\t  }";
   }
 }
+
+std::string_view color_name(const Color& color) {
+  switch (color) {
+    case Color::Grey:
+      return "gray";
+    case Color::Green:
+      return "green";
+    case Color::Yellow:
+      return "yellow";
+    case Color::Red:
+      return "red";
+  }
+}
 }  // namespace
 
 std::string GraphPrinter::print_vertex(const Vertex& vertex) const {
-  std::string str_vertex = "\t  {\n\t\t\"id\":" + std::to_string(vertex.id) +
-                           ",\n\t\t\"edge_ids\":[";
-  for (const auto& edge_id : vertex.get_edge_ids()) {
-    str_vertex += std::to_string(edge_id);
-    if (edge_id != vertex.get_edge_ids().back())
-      str_vertex += ",";
-  }
-  str_vertex += "],\n\t\t\"depth\":" + std::to_string(vertex.depth) + "\n\t  }";
+  std::string str_vertex;
+  print_vertex(vertex, str_vertex);
   return str_vertex;
 }
 
 std::string GraphPrinter::print_edge(const Edge& edge) const {
-  return "\t  {\n\t\t\"id\":" + std::to_string(edge.id) +
-         ",\n\t\t\"vertex_ids\":[" + std::to_string(edge.vertex_start) + "," +
-         std::to_string(edge.vertex_end) +
-         "],\n\t\t\"color\": " + edge_color_to_string(edge.color);
+  std::string str_edge;
+  print_edge(edge, str_edge);
+  return str_edge;
 }
 
 std::string GraphPrinter::print() const {
-  std::string graph_string = "{";
+  std::string graph_string;
+  print(graph_string);
+  return graph_string;
+}
+
+void GraphPrinter::print_vertex(const Vertex& vertex,
+                                std::string& buffer) const {
+  print_vertex(vertex, vertex.get_edge_ids(), buffer);
+}
+
+void GraphPrinter::print_vertex(const Vertex& vertex,
+                                const std::vector<EdgeId>& edge_ids,
+                                std::string& buffer) const {
+  buffer += "\t  {\n\t\t\"id\":";
+  append_number(buffer, vertex.id);
+  buffer += ",\n\t\t\"edge_ids\":[";
+  for (const auto& edge_id : edge_ids) {
+    append_number(buffer, edge_id);
+    if (edge_id != edge_ids.back())
+      buffer += ",";
+  }
+  buffer += "],\n\t\t\"depth\":";
+  append_number(buffer, vertex.depth);
+  buffer += "\n\t  }";
+}
+
+void GraphPrinter::print_edge(const Edge& edge, std::string& buffer) const {
+  buffer += "\t  {\n\t\t\"id\":";
+  append_number(buffer, edge.id);
+  buffer += ",\n\t\t\"vertex_ids\":[";
+  append_number(buffer, edge.vertex_start);
+  buffer += ",";
+  append_number(buffer, edge.vertex_end);
+  buffer += "],\n\t\t\"color\": ";
+  buffer += edge_color_to_string(edge.color);
+}
+
+void GraphPrinter::print(std::string& buffer) const {
+  switch (level_of_detail_.mode) {
+    case LevelOfDetail::Mode::Full:
+      print_full(buffer);
+      return;
+    case LevelOfDetail::Mode::DepthLimited:
+      print_depth_limited(level_of_detail_.max_depth, buffer);
+      return;
+    case LevelOfDetail::Mode::Sampled:
+      print_sampled(level_of_detail_.sample_size, level_of_detail_.seed,
+                    buffer);
+      return;
+    case LevelOfDetail::Mode::Summary:
+      print_summary(buffer);
+      return;
+  }
+}
+
+void GraphPrinter::print_full(std::string& buffer) const {
+  buffer += "{";
 
   // write graph depth
-  graph_string +=
-      "\n\t\"depth\": " + std::to_string(graph_.get_depth_map().size() - 1) +
-      ",";
+  buffer += "\n\t\"depth\": ";
+  append_number(buffer, graph_.get_depth_map().size() - 1);
+  buffer += ",";
 
   // write vertices
-  graph_string += "\n\t\"vertices\": [\n";
+  buffer += "\n\t\"vertices\": [\n";
   for (const auto& vertex : graph_.get_vertices()) {
-    graph_string += print_vertex(vertex);
+    print_vertex(vertex, buffer);
     if (vertex.id != graph_.get_vertices().back().id)
-      graph_string += ",\n";
+      buffer += ",\n";
   }
-  graph_string += "\n\t],";
+  buffer += "\n\t],";
 
   // write edges
-  graph_string += "\n\t\"edges\": [\n";
+  buffer += "\n\t\"edges\": [\n";
   for (const auto& edge : graph_.get_edges()) {
-    graph_string += print_edge(edge);
+    print_edge(edge, buffer);
     if (edge.id != graph_.get_edges().back().id)
-      graph_string += ",\n";
+      buffer += ",\n";
   }
-  graph_string += "\n\t]";
+  buffer += "\n\t]";
 
-  graph_string += "\n}\n";
-  return graph_string;
+  buffer += "\n}\n";
+}
+
+// write only the vertices of vertex_ids and the edges between them
+template <typename IsSelected>
+void GraphPrinter::print_subgraph(const std::vector<VertexId>& vertex_ids,
+                                  const Depth& depth,
+                                  const IsSelected& is_selected,
+                                  std::string& buffer) const {
+  std::vector<EdgeId> vertex_edge_ids;
+  std::vector<EdgeId> edge_ids;
+  buffer += "{";
+
+  buffer += "\n\t\"depth\": ";
+  append_number(buffer, depth);
+  buffer += ",";
+
+  buffer += "\n\t\"vertices\": [\n";
+  for (std::size_t i = 0; i < vertex_ids.size(); i++) {
+    if (i != 0)
+      buffer += ",\n";
+    const auto& vertex = graph_.get_vertex(vertex_ids[i]);
+    vertex_edge_ids.clear();
+    for (const auto& edge_id : vertex.get_edge_ids()) {
+      const auto& edge = graph_.get_edge(edge_id);
+      const bool is_start = edge.vertex_start == vertex.id;
+      if (!is_selected(is_start ? edge.vertex_end : edge.vertex_start))
+        continue;
+      vertex_edge_ids.push_back(edge_id);
+      // add the edge from its start vertex only, not twice
+      if (is_start)
+        edge_ids.push_back(edge_id);
+    }
+    print_vertex(vertex, vertex_edge_ids, buffer);
+  }
+  buffer += "\n\t],";
+
+  std::sort(edge_ids.begin(), edge_ids.end());
+  buffer += "\n\t\"edges\": [\n";
+  for (std::size_t i = 0; i < edge_ids.size(); i++) {
+    if (i != 0)
+      buffer += ",\n";
+    print_edge(graph_.get_edge(edge_ids[i]), buffer);
+  }
+  buffer += "\n\t]";
+
+  buffer += "\n}\n";
+}
+
+void GraphPrinter::print_depth_limited(const Depth& max_depth,
+                                       std::string& buffer) const {
+  const auto& depth_map = graph_.get_depth_map();
+  const Depth depth = std::min<Depth>(max_depth, depth_map.size() - 1);
+  std::vector<VertexId> vertex_ids;
+  for (Depth level = 0; level <= depth; level++)
+    vertex_ids.insert(vertex_ids.end(), depth_map[level].begin(),
+                      depth_map[level].end());
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  print_subgraph(
+      vertex_ids, depth,
+      [this, max_depth](const VertexId& vertex_id) {
+        return graph_.get_vertex(vertex_id).depth <= max_depth;
+      },
+      buffer);
+}
+
+void GraphPrinter::print_sampled(int sample_size,
+                                 unsigned int seed,
+                                 std::string& buffer) const {
+  // pick sample_size different vertices, one draw each (Floyd's algorithm)
+  const int vertices_count = graph_.get_vertices().size();
+  sample_size = std::min(sample_size, vertices_count);
+  std::mt19937 random_engine(seed);
+  std::unordered_set<VertexId> sample;
+  sample.reserve(sample_size);
+  for (int last = vertices_count - sample_size; last < vertices_count;
+       last++) {
+    const VertexId vertex_id =
+        std::uniform_int_distribution<VertexId>(0, last)(random_engine);
+    if (!sample.insert(vertex_id).second)
+      sample.insert(last);
+  }
+
+  std::vector<VertexId> vertex_ids(sample.begin(), sample.end());
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  // the depth of the deepest sampled vertex
+  Depth depth = 0;
+  for (const auto& vertex_id : vertex_ids)
+    depth = std::max(depth, graph_.get_vertex(vertex_id).depth);
+  print_subgraph(
+      vertex_ids, depth,
+      [&sample](const VertexId& vertex_id) { return sample.count(vertex_id); },
+      buffer);
+}
+
+// count edges by color, the graph doesn't keep them grouped
+void GraphPrinter::print_summary(std::string& buffer) const {
+  std::array<int, COLORS.size()> color_counts = {};
+  for (const auto& edge : graph_.get_edges())
+    color_counts[static_cast<int>(edge.color)]++;
+
+  const auto& depth_map = graph_.get_depth_map();
+  buffer += "{";
+  buffer += "\n\t\"depth\": ";
+  append_number(buffer, depth_map.size() - 1);
+  buffer += ",\n\t\"vertices\": ";
+  append_number(buffer, graph_.get_vertices().size());
+  buffer += ",\n\t\"edges\": ";
+  append_number(buffer, graph_.get_edges().size());
+  buffer += ",\n\t\"vertices_per_depth\": [";
+  for (std::size_t depth = 0; depth < depth_map.size(); depth++) {
+    if (depth != 0)
+      buffer += ", ";
+    append_number(buffer, depth_map[depth].size());
+  }
+  buffer += "],\n\t\"edges_per_color\": { ";
+  for (std::size_t i = 0; i < COLORS.size(); i++) {
+    if (i != 0)
+      buffer += ", ";
+    buffer += "\"";
+    buffer += color_name(COLORS[i]);
+    buffer += "\": ";
+    append_number(buffer, color_counts[static_cast<int>(COLORS[i])]);
+  }
+  buffer += " }\n}\n";
 }
@@ -3,15 +3,73 @@
 #include "graph.hpp"
 
 #include <string>
+#include <vector>
+
+// what print() writes: whole graph, vertices up to a depth, random vertices
+// or only the numbers of vertices and edges
+struct LevelOfDetail {
+  enum class Mode { Full, DepthLimited, Sampled, Summary };
+
+  Mode mode = Mode::Full;
+  // for DepthLimited
+  Depth max_depth = 0;
+  // for Sampled
+  int sample_size = 0;
+  unsigned int seed = 0;
+
+  static LevelOfDetail depth_limited(const Depth& max_depth) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::DepthLimited;
+    level_of_detail.max_depth = max_depth;
+    return level_of_detail;
+  }
+  static LevelOfDetail sampled(int sample_size, unsigned int seed) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Sampled;
+    level_of_detail.sample_size = sample_size;
+    level_of_detail.seed = seed;
+    return level_of_detail;
+  }
+  // vertices per depth and edges per color only
+  static LevelOfDetail summary() {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Summary;
+    return level_of_detail;
+  }
+};
 
 class GraphPrinter {
  public:
-  explicit GraphPrinter(const Graph& graph) : graph_(graph) {}
+  explicit GraphPrinter(const Graph& graph,
+                        const LevelOfDetail& level_of_detail = LevelOfDetail())
+      : graph_(graph), level_of_detail_(level_of_detail) {}
 
   std::string print() const;
   std::string print_vertex(const Vertex& vertex) const;
   std::string print_edge(const Edge& edge) const;
 
+  // append to the buffer instead of building temporary strings
+  void print(std::string& buffer) const;
+  void print_vertex(const Vertex& vertex, std::string& buffer) const;
+  void print_edge(const Edge& edge, std::string& buffer) const;
+
  private:
   const Graph& graph_;
+  const LevelOfDetail level_of_detail_;
+
+  void print_full(std::string& buffer) const;
+  void print_vertex(const Vertex& vertex,
+                    const std::vector<EdgeId>& edge_ids,
+                    std::string& buffer) const;
+  // vertices of vertex_ids and the edges whose both ends is_selected takes
+  template <typename IsSelected>
+  void print_subgraph(const std::vector<VertexId>& vertex_ids,
+                      const Depth& depth,
+                      const IsSelected& is_selected,
+                      std::string& buffer) const;
+  void print_depth_limited(const Depth& max_depth, std::string& buffer) const;
+  void print_sampled(int sample_size,
+                     unsigned int seed,
+                     std::string& buffer) const;
+  void print_summary(std::string& buffer) const;
 };
@@ -0,0 +1,64 @@
+#include "date_time.hpp"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+
+namespace {
+constexpr auto FORMAT = "%Y.%m.%d %H:%M:%S";
+constexpr int MICROSECONDS_DIGITS = 6;
+
+struct CachedDateTime {
+  std::time_t time = -1;
+  std::array<char, 64> buffer;
+  std::size_t length = 0;
+};
+
+CachedDateTime& get_cached_date_time() {
+  thread_local CachedDateTime cached;
+  const auto time =
+      std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  if (time != cached.time) {
+    std::tm local_time;
+    localtime_r(&time, &local_time);
+    cached.length = std::strftime(cached.buffer.data(), cached.buffer.size(),
+                                  FORMAT, &local_time);
+    cached.time = time;
+  }
+  return cached;
+}
+}  // namespace
+
+namespace uni_cpp_practice {
+std::string_view get_current_date_time() {
+  const auto& cached = get_cached_date_time();
+  return {cached.buffer.data(), cached.length};
+}
+
+std::string_view get_current_precise_date_time() {
+  static const auto start = std::chrono::steady_clock::now();
+  const auto microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  auto& cached = get_cached_date_time();
+  char* const begin = cached.buffer.data();
+  char* const end = begin + cached.buffer.size();
+  char* position = begin + cached.length;
+  *position++ = ' ';
+  *position++ = '[';
+  position = std::to_chars(position, end, microseconds / 1000000).ptr;
+  *position++ = '.';
+  auto fraction = microseconds % 1000000;
+  for (int i = MICROSECONDS_DIGITS - 1; i >= 0; i--) {
+    position[i] = static_cast<char>('0' + fraction % 10);
+    fraction /= 10;
+  }
+  position += MICROSECONDS_DIGITS;
+  *position++ = ']';
+  return {begin, static_cast<std::size_t>(position - begin)};
+}
+}  // namespace uni_cpp_practice
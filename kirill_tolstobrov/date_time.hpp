@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string_view>
+
+namespace uni_cpp_practice {
+// Log line timestamps. localtime_r runs at most once a second per thread, the
+// view is valid until the next call on the same thread
+
+// "2024.01.31 12:00:00"
+std::string_view get_current_date_time();
+
+// get_current_date_time() with the monotonic time since the first call:
+// "2024.01.31 12:00:00 [12.345678]"
+std::string_view get_current_precise_date_time();
+}  // namespace uni_cpp_practice
@@ -0,0 +1,74 @@
+#include "file_writer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace uni_cpp_practice {
+FileWriter::FileWriter(const std::string& filename) : buffer_(BUFFER_SIZE) {
+  file_descriptor_ =
+      ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor_ == -1) {
+    throw std::runtime_error("Can't open file " + filename);
+  }
+}
+
+FileWriter::~FileWriter() {
+  if (file_descriptor_ == -1) {
+    return;
+  }
+  try {
+    flush();
+  } catch (const std::runtime_error&) {
+    // can't throw from destructor, close() reports errors instead
+  }
+  ::close(file_descriptor_);
+}
+
+void FileWriter::append(std::string_view data) {
+  if (buffer_size_ + data.size() > buffer_.size()) {
+    flush();
+    // bigger than the whole buffer, no point in copying
+    if (data.size() >= buffer_.size()) {
+      write_all(data.data(), data.size());
+      return;
+    }
+  }
+  std::memcpy(buffer_.data() + buffer_size_, data.data(), data.size());
+  buffer_size_ += data.size();
+}
+
+void FileWriter::flush() {
+  write_all(buffer_.data(), buffer_size_);
+  buffer_size_ = 0;
+}
+
+void FileWriter::close() {
+  if (file_descriptor_ == -1) {
+    return;
+  }
+  flush();
+  const int file_descriptor = file_descriptor_;
+  file_descriptor_ = -1;
+  if (::close(file_descriptor) == -1) {
+    throw std::runtime_error("Can't close file");
+  }
+}
+
+void FileWriter::write_all(const char* data, std::size_t size) {
+  while (size > 0) {
+    const auto written = ::write(file_descriptor_, data, size);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Can't write to file");
+    }
+    data += written;
+    size -= written;
+  }
+}
+}  // namespace uni_cpp_practice
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace uni_cpp_practice {
+// Buffered writer to a file descriptor. Memory use is BUFFER_SIZE no matter
+// how much is written
+class FileWriter {
+ public:
+  static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+  explicit FileWriter(const std::string& filename);
+  ~FileWriter();
+
+  void append(std::string_view data);
+  void append(const char* data, std::size_t size) {
+    append(std::string_view(data, size));
+  }
+  void flush();
+  void close();
+
+ private:
+  int file_descriptor_ = -1;
+  std::vector<char> buffer_;
+  std::size_t buffer_size_ = 0;
+
+  void write_all(const char* data, std::size_t size);
+
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+  FileWriter(FileWriter&&) = delete;
+  FileWriter& operator=(FileWriter&&) = delete;
+};
+}  // namespace uni_cpp_practice
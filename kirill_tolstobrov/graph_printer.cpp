@@ -1,6 +1,234 @@
 #include "graph_printer.hpp"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <iostream>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_NUMBER_LENGTH = 11;
+
+// Output is std::string or FileWriter
+
+template <typename Output>
+void append_number(Output& output, int number) {
+  std::array<char, MAX_NUMBER_LENGTH> digits;
+  const auto result =
+      std::to_chars(digits.data(), digits.data() + digits.size(), number);
+  output.append(digits.data(), result.ptr - digits.data());
+}
+
+using uni_cpp_practice::EdgeId;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::LevelOfDetail;
+using uni_cpp_practice::VertexId;
+
+constexpr std::array<uni_cpp_practice::Edge::Color, 5> COLORS = {
+    uni_cpp_practice::Edge::Color::Grey, uni_cpp_practice::Edge::Color::Green,
+    uni_cpp_practice::Edge::Color::Blue, uni_cpp_practice::Edge::Color::Yellow,
+    uni_cpp_practice::Edge::Color::Red};
+
+template <typename Output>
+void write_vertex(const uni_cpp_practice::Vertex& vertex,
+                  const std::vector<EdgeId>& edge_ids,
+                  Output& output) {
+  output.append("{\n\"id\": ");
+  append_number(output, vertex.id);
+  output.append(",\n\"edge_ids\": [");
+
+  for (int i = 0; i < edge_ids.size(); i++) {
+    if (i != 0) {
+      output.append(", ");
+    }
+    append_number(output, edge_ids[i]);
+  }
+  output.append("],\n");
+
+  output.append("\"depth\": ");
+  append_number(output, vertex.depth);
+  output.append("\n}");
+}
+
+template <typename Output>
+void write_edge(const uni_cpp_practice::Edge& edge, Output& output) {
+  output.append("{\n\"id\": ");
+  append_number(output, edge.id);
+  output.append(",\n\"vertex_ids\": ");
+
+  output.append("[");
+  append_number(output, edge.vertex1_id);
+  output.append(", ");
+  append_number(output, edge.vertex2_id);
+  output.append("],\n\"color\": \"");
+  output.append(uni_cpp_practice::GraphPrinter::color_to_string(edge.color));
+  output.append("\"\n}");
+}
+
+template <typename Output>
+void write_graph(const uni_cpp_practice::Graph& graph, Output& output) {
+  output.append("{\n  \"vertices\": [\n");
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+  for (int i = 0; i < vertices.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    write_vertex(vertices[i], vertices[i].get_edge_ids(), output);
+  }
+
+  output.append("\n  ],\n  \"edges\": [\n");
+
+  for (int i = 0; i < edges.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    write_edge(edges[i], output);
+  }
+
+  output.append("\n  ]\n}");
+}
+
+// Like write_graph, but only for `vertex_ids`, which must be sorted. An edge
+// is written when `is_selected` accepts its other vertex too.
+template <typename Output, typename IsSelected>
+void write_subgraph(const Graph& graph,
+                    const std::vector<VertexId>& vertex_ids,
+                    const IsSelected& is_selected,
+                    Output& output) {
+  const auto& edges = graph.get_edges();
+  std::vector<EdgeId> vertex_edge_ids;
+  std::vector<EdgeId> edge_ids;
+  output.append("{\n  \"vertices\": [\n");
+  for (std::size_t i = 0; i < vertex_ids.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    const auto& vertex = graph.get_vertex(vertex_ids[i]);
+    vertex_edge_ids.clear();
+    for (const auto& edge_id : vertex.get_edge_ids()) {
+      const auto& edge = edges[edge_id];
+      const bool is_first = edge.vertex1_id == vertex.id;
+      if (!is_selected(is_first ? edge.vertex2_id : edge.vertex1_id))
+        continue;
+      vertex_edge_ids.push_back(edge_id);
+      // So that both vertices don't add it
+      if (is_first)
+        edge_ids.push_back(edge_id);
+    }
+    write_vertex(vertex, vertex_edge_ids, output);
+  }
+
+  std::sort(edge_ids.begin(), edge_ids.end());
+  output.append("\n  ],\n  \"edges\": [\n");
+  for (std::size_t i = 0; i < edge_ids.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    write_edge(edges[edge_ids[i]], output);
+  }
+  output.append("\n  ]\n}");
+}
+
+template <typename Output>
+void write_depth_limited(const Graph& graph, int max_depth, Output& output) {
+  std::vector<VertexId> vertex_ids;
+  const auto& depths_map = graph.depths_map_;
+  const int last_depth =
+      std::min(max_depth, static_cast<int>(depths_map.size()) - 1);
+  for (int depth = 0; depth <= last_depth; depth++) {
+    vertex_ids.insert(vertex_ids.end(), depths_map[depth].begin(),
+                      depths_map[depth].end());
+  }
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  write_subgraph(
+      graph, vertex_ids,
+      [&graph, max_depth](const VertexId& vertex_id) {
+        return graph.get_vertex(vertex_id).depth <= max_depth;
+      },
+      output);
+}
+
+template <typename Output>
+void write_sampled(const Graph& graph,
+                   int sample_size,
+                   unsigned int seed,
+                   Output& output) {
+  // Floyd's sampling, one draw per sampled vertex
+  const int vertices_count = graph.get_vertices().size();
+  sample_size = std::min(sample_size, vertices_count);
+  std::mt19937 random_engine(seed);
+  std::unordered_set<VertexId> sample;
+  sample.reserve(sample_size);
+  for (int last = vertices_count - sample_size; last < vertices_count;
+       last++) {
+    const VertexId vertex_id =
+        std::uniform_int_distribution<VertexId>(0, last)(random_engine);
+    if (!sample.insert(vertex_id).second)
+      sample.insert(last);
+  }
+
+  std::vector<VertexId> vertex_ids(sample.begin(), sample.end());
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  write_subgraph(
+      graph, vertex_ids,
+      [&sample](const VertexId& vertex_id) { return sample.count(vertex_id); },
+      output);
+}
+
+template <typename Output>
+void write_summary(const Graph& graph, Output& output) {
+  const auto& depths_map = graph.depths_map_;
+  output.append("{\n  \"depth\": ");
+  append_number(output, depths_map.empty() ? 0 : depths_map.size() - 1);
+  output.append(",\n  \"vertices\": ");
+  append_number(output, graph.get_vertices().size());
+  output.append(",\n  \"edges\": ");
+  append_number(output, graph.get_edges().size());
+  output.append(",\n  \"vertices_per_depth\": [");
+  for (std::size_t depth = 0; depth < depths_map.size(); depth++) {
+    if (depth != 0)
+      output.append(", ");
+    append_number(output, depths_map[depth].size());
+  }
+  output.append("],\n  \"edges_per_color\": { ");
+  const auto& colors_map = graph.get_colors_map();
+  for (std::size_t i = 0; i < COLORS.size(); i++) {
+    if (i != 0)
+      output.append(", ");
+    output.append("\"");
+    output.append(uni_cpp_practice::GraphPrinter::color_to_string(COLORS[i]));
+    output.append("\": ");
+    const auto color_edge_ids = colors_map.find(COLORS[i]);
+    append_number(output, color_edge_ids == colors_map.end()
+                              ? 0
+                              : color_edge_ids->second.size());
+  }
+  output.append(" }\n}");
+}
+
+template <typename Output>
+void write_level_of_detail(const Graph& graph,
+                           const LevelOfDetail& level_of_detail,
+                           Output& output) {
+  switch (level_of_detail.mode) {
+    case LevelOfDetail::Mode::Full:
+      write_graph(graph, output);
+      return;
+    case LevelOfDetail::Mode::DepthLimited:
+      write_depth_limited(graph, level_of_detail.max_depth, output);
+      return;
+    case LevelOfDetail::Mode::Sampled:
+      write_sampled(graph, level_of_detail.sample_size, level_of_detail.seed,
+                    output);
+      return;
+    case LevelOfDetail::Mode::Summary:
+      write_summary(graph, output);
+      return;
+  }
+}
+
+}  // namespace
 
 namespace uni_cpp_practice {
 
@@ -23,56 +251,37 @@ std::string GraphPrinter::color_to_string(
 
 std::string GraphPrinter::print_vertex(const uni_cpp_practice::Vertex& vertex) {
   std::string result = "";
-  auto edge_ids = vertex.get_edge_ids();
-  result += "{\n\"id\": " + std::to_string(vertex.id);
-  result += ",\n\"edge_ids\": [";
-
-  for (int i = 0; i < edge_ids.size(); i++) {
-    result += std::to_string(edge_ids[i]);
-    if (i != edge_ids.size() - 1) {
-      result += ", ";
-    }
-  }
-  result += "],\n";
-
-  result += "\"depth\": " + std::to_string(vertex.depth);
-  result += "\n}";
+  print_vertex(vertex, result);
   return result;
 }
 
 std::string GraphPrinter::print_edge(const uni_cpp_practice::Edge& edge) {
   std::string result = "";
-  result += "{\n\"id\": " + std::to_string(edge.id);
-  result += ",\n\"vertex_ids\": ";
-
-  result += "[" + std::to_string(edge.vertex1_id);
-  result += ", " + std::to_string(edge.vertex2_id);
-  result += "],\n\"color\": \"";
-  result += color_to_string(edge.color);
-  result += "\"\n}";
-
+  print_edge(edge, result);
   return result;
 }
 
 std::string GraphPrinter::print() const {
-  std::string result = "{\n  \"vertices\": [\n";
-  auto vertices = graph_.get_vertices();
-  auto edges = graph_.get_edges();
-  for (int i = 0; i < vertices.size(); i++) {
-    result += print_vertex(vertices[i]);
-    if (i != vertices.size() - 1)
-      result += ",\n";
-  }
+  std::string result = "";
+  print(result);
+  return result;
+}
 
-  result += "\n  ],\n  \"edges\": [\n";
+void GraphPrinter::print_vertex(const uni_cpp_practice::Vertex& vertex,
+                                std::string& buffer) {
+  write_vertex(vertex, vertex.get_edge_ids(), buffer);
+}
 
-  for (int i = 0; i < edges.size(); i++) {
-    result += print_edge(edges[i]);
-    if (i != edges.size() - 1)
-      result += ",\n";
-  }
+void GraphPrinter::print_edge(const uni_cpp_practice::Edge& edge,
+                              std::string& buffer) {
+  write_edge(edge, buffer);
+}
 
-  result += "\n  ]\n}";
-  return result;
+void GraphPrinter::print(std::string& buffer) const {
+  write_level_of_detail(graph_, level_of_detail_, buffer);
+}
+
+void GraphPrinter::print(FileWriter& writer) const {
+  write_level_of_detail(graph_, level_of_detail_, writer);
 }
 }  // namespace uni_cpp_practice
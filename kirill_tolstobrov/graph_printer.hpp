@@ -1,20 +1,69 @@
 #pragma once
 
+#include "file_writer.hpp"
 #include "graph.hpp"
 
 #include <iostream>
+#include <string>
 
 namespace uni_cpp_practice {
+// What print() writes: the whole graph, the vertices up to a depth, a
+// random sample of vertices or only the counts. The last three cost what
+// they write.
+struct LevelOfDetail {
+  enum class Mode { Full, DepthLimited, Sampled, Summary };
+
+  Mode mode = Mode::Full;
+  // For DepthLimited
+  int max_depth = 0;
+  // For Sampled, edges are kept if both vertices are sampled
+  int sample_size = 0;
+  unsigned int seed = 0;
+
+  static LevelOfDetail depth_limited(int max_depth) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::DepthLimited;
+    level_of_detail.max_depth = max_depth;
+    return level_of_detail;
+  }
+  static LevelOfDetail sampled(int sample_size, unsigned int seed) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Sampled;
+    level_of_detail.sample_size = sample_size;
+    level_of_detail.seed = seed;
+    return level_of_detail;
+  }
+  // Only the number of vertices per depth and of edges per color
+  static LevelOfDetail summary() {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Summary;
+    return level_of_detail;
+  }
+};
+
 class GraphPrinter {
  public:
-  explicit GraphPrinter(const Graph& graph) : graph_(graph) {}
+  explicit GraphPrinter(const Graph& graph,
+                        const LevelOfDetail& level_of_detail = LevelOfDetail())
+      : graph_(graph), level_of_detail_(level_of_detail) {}
   static std::string color_to_string(
       const uni_cpp_practice::Edge::Color& color);
   static std::string print_vertex(const uni_cpp_practice::Vertex& vertex);
   static std::string print_edge(const uni_cpp_practice::Edge& edge);
   std::string print() const;
 
+  // Same as above, but append to the buffer so it can be reused
+  static void print_vertex(const uni_cpp_practice::Vertex& vertex,
+                           std::string& buffer);
+  static void print_edge(const uni_cpp_practice::Edge& edge,
+                         std::string& buffer);
+  void print(std::string& buffer) const;
+
+  // Streams the graph, the whole JSON is never kept in memory
+  void print(FileWriter& writer) const;
+
  private:
   const Graph& graph_;
+  const LevelOfDetail level_of_detail_;
 };
 }  // namespace uni_cpp_practice
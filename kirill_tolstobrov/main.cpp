@@ -1,9 +1,6 @@
 #include <algorithm>
 #include <cassert>
-#include <chrono>
 #include <filesystem>
-#include <fstream>
-#include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <map>
@@ -11,19 +8,14 @@
 #include <sstream>
 #include <vector>
 
+#include "date_time.hpp"
+#include "file_writer.hpp"
 #include "graph.hpp"
 #include "graph_generator.hpp"
 #include "graph_printer.hpp"
 #include "logger.hpp"
 
-std::string get_current_date_time() {
-  const auto date_time = std::chrono::system_clock::now();
-  const auto date_time_t = std::chrono::system_clock::to_time_t(date_time);
-  std::stringstream date_time_string;
-  date_time_string << std::put_time(std::localtime(&date_time_t),
-                                    "%Y.%m.%d %H:%M:%S");
-  return date_time_string.str();
-}
+using uni_cpp_practice::get_current_date_time;
 
 const std::string logger_start_string(int graph_number) {
   std::stringstream string;
@@ -118,14 +110,12 @@ uni_cpp_practice::Logger& prepare_logger() {
   return logger;
 }
 
-void write_to_file(const std::string& string, const std::string& filename) {
-  std::ofstream file;
-  file.open(filename);
-
-  if (file.is_open()) {
-    file << string << std::endl;
-    file.close();
-  }
+void write_to_file(const uni_cpp_practice::GraphPrinter& graph_printer,
+                   const std::string& filename) {
+  uni_cpp_practice::FileWriter file(filename);
+  graph_printer.print(file);
+  file.append("\n");
+  file.close();
 }
 
 int main() {
@@ -148,7 +138,7 @@ int main() {
 
     const uni_cpp_practice::GraphPrinter graph_printer(graph);
 
-    write_to_file(graph_printer.print(),
+    write_to_file(graph_printer,
                   "temp/graph_" + std::to_string(i + 1) + ".json");
   }
 
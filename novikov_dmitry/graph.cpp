@@ -93,7 +93,7 @@ std::string color_to_string(const Edge::Color& color) {
 VertexId Graph::add_vertex() {
   const auto new_vertex_id = get_default_vertex_id();
   vertex_map_.insert({new_vertex_id, Vertex(new_vertex_id)});
-  get_mutable_vertices_at_depth(DEFAULT_DEPTH).push_back(new_vertex_id);
+  add_vertex_to_depth_level(new_vertex_id, DEFAULT_DEPTH);
   return new_vertex_id;
 }
 
@@ -187,18 +187,34 @@ void Graph::set_vertex_depth(const VertexId& from_vertex_id,
   const auto new_son_vertex_depth = get_vertex(parent_vertex_id).depth + 1;
 
   auto& son_vertex = get_mutable_vertex(son_vertex_id);
-  auto& depth_map_son_level = get_mutable_vertices_at_depth(son_vertex.depth);
-
-  const auto vertex_iter_at_depth_map = std::remove(
-      depth_map_son_level.begin(), depth_map_son_level.end(), son_vertex.id);
-  depth_map_son_level.erase(vertex_iter_at_depth_map);
+  remove_vertex_from_depth_level(son_vertex.id, son_vertex.depth);
   son_vertex.depth = new_son_vertex_depth;
+  add_vertex_to_depth_level(son_vertex.id, new_son_vertex_depth);
+}
 
-  if (depth_map_.size() <= new_son_vertex_depth) {
-    depth_map_.push_back(std::vector<VertexId>({son_vertex.id}));
-  } else {
-    get_mutable_vertices_at_depth(new_son_vertex_depth)
-        .push_back(son_vertex.id);
+void Graph::add_vertex_to_depth_level(const VertexId& id, const Depth& depth) {
+  if (static_cast<Depth>(depth_map_.size()) <= depth) {
+    depth_map_.emplace_back();
+  }
+  auto& depth_level = get_mutable_vertices_at_depth(depth);
+  if (static_cast<VertexId>(depth_map_positions_.size()) <= id) {
+    depth_map_positions_.resize(id + 1);
   }
+  depth_map_positions_[id] = depth_level.size();
+  depth_level.push_back(id);
+}
+
+void Graph::remove_vertex_from_depth_level(const VertexId& id,
+                                           const Depth& depth) {
+  // Удаление обменом с последним элементом уровня: порядок остальных вершин
+  // уровня может измениться, но только что добавленная вершина всегда
+  // последняя, поэтому при генерации порядок уровней сохраняется
+  auto& depth_level = get_mutable_vertices_at_depth(depth);
+  const int position = depth_map_positions_[id];
+  assert(depth_level[position] == id && "Vertex is not at this depth level");
+  const VertexId last_vertex_id = depth_level.back();
+  depth_level[position] = last_vertex_id;
+  depth_map_positions_[last_vertex_id] = position;
+  depth_level.pop_back();
 }
 }  // namespace uni_cpp_practice
@@ -101,6 +101,9 @@ class Graph {
   std::unordered_map<VertexId, Vertex> vertex_map_;
   std::unordered_map<EdgeId, Edge> edge_map_;
   std::vector<std::vector<VertexId>> depth_map_ = {{}};
+  // Позиция каждой вершины внутри её уровня в depth_map_ (индекс - VertexId),
+  // позволяет переносить вершину между уровнями за O(1)
+  std::vector<int> depth_map_positions_;
 
   VertexId get_default_vertex_id() { return default_vertex_id_++; }
 
@@ -120,5 +123,9 @@ class Graph {
 
   void set_vertex_depth(const VertexId& from_vertex_id,
                         const VertexId& to_vertex_id);
+
+  void add_vertex_to_depth_level(const VertexId& id, const Depth& depth);
+
+  void remove_vertex_from_depth_level(const VertexId& id, const Depth& depth);
 };
 }  // namespace uni_cpp_practice
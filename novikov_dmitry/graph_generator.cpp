@@ -5,6 +5,7 @@
 #include <functional>
 #include <limits>
 #include <list>
+#include <optional>
 #include <random>
 #include <thread>
 
@@ -1,15 +1,30 @@
 #include "graph_printer.hpp"
 
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
 namespace {
 
-std::string print_vertex(const uni_cpp_practice::Vertex& vertex) {
+using uni_cpp_practice::Depth;
+using uni_cpp_practice::EdgeId;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::LevelOfDetail;
+using uni_cpp_practice::VertexId;
+
+const std::vector<uni_cpp_practice::Edge::Color> COLORS = {
+    uni_cpp_practice::Edge::Color::Gray, uni_cpp_practice::Edge::Color::Green,
+    uni_cpp_practice::Edge::Color::Blue, uni_cpp_practice::Edge::Color::Yellow,
+    uni_cpp_practice::Edge::Color::Red};
+
+std::string print_vertex(const uni_cpp_practice::Vertex& vertex,
+                         const std::vector<EdgeId>& edge_ids) {
   std::stringstream ss_out;
   std::string tab_1 = "    ";
   std::string tab_2 = tab_1 + tab_1;
   ss_out << tab_2 << "{\n";
   ss_out << tab_2 << tab_1 << "\"id\": " << vertex.id << ",\n";
   ss_out << tab_2 << tab_1 << "\"edge_ids\": [";
-  const auto& edge_ids = vertex.get_edge_ids();
   for (auto it = edge_ids.begin(); it != edge_ids.end(); ++it) {
     if (it != edge_ids.begin()) {
       ss_out << ", ";
@@ -38,26 +53,24 @@ std::string print_edge(const uni_cpp_practice::Edge& edge) {
   ss_out << tab_2 << "}";
   return ss_out.str();
 }
-}  // namespace
 
-namespace uni_cpp_practice {
-std::string GraphPrinter::print() const {
+std::string print_full(const Graph& graph) {
   std::stringstream ss_out;
   std::string tab_1 = "    ";
   ss_out << "{\n";
-  ss_out << tab_1 << "\"depth\": " << graph_.get_depth() << ",\n";
+  ss_out << tab_1 << "\"depth\": " << graph.get_depth() << ",\n";
   ss_out << tab_1 << "\"vertices\": [\n";
-  const auto& vertex_map = graph_.get_vertex_map();
+  const auto& vertex_map = graph.get_vertex_map();
   for (auto it = vertex_map.begin(); it != vertex_map.end(); ++it) {
     if (it != vertex_map.begin()) {
       ss_out << ", ";
     }
-    ss_out << print_vertex(it->second);
+    ss_out << print_vertex(it->second, it->second.get_edge_ids());
   }
   ss_out << std::endl << tab_1 << "],\n";
 
   ss_out << tab_1 << "\"edges\": [\n";
-  const auto& edge_map = graph_.get_edge_map();
+  const auto& edge_map = graph.get_edge_map();
   for (auto it = edge_map.begin(); it != edge_map.end(); ++it) {
     if (it != edge_map.begin()) {
       ss_out << ", ";
@@ -68,4 +81,147 @@ std::string GraphPrinter::print() const {
   ss_out << "}" << std::endl;
   return ss_out.str();
 }
+
+// The vertices of `vertex_ids` and the edges between them
+template <typename IsSelected>
+std::string print_subgraph(const Graph& graph,
+                           const std::vector<VertexId>& vertex_ids,
+                           const Depth& depth,
+                           const IsSelected& is_selected) {
+  std::stringstream ss_out;
+  std::string tab_1 = "    ";
+  std::vector<EdgeId> vertex_edge_ids;
+  std::vector<EdgeId> edge_ids;
+  ss_out << "{\n";
+  ss_out << tab_1 << "\"depth\": " << depth << ",\n";
+  ss_out << tab_1 << "\"vertices\": [\n";
+  for (auto it = vertex_ids.begin(); it != vertex_ids.end(); ++it) {
+    if (it != vertex_ids.begin()) {
+      ss_out << ", ";
+    }
+    const auto& vertex = graph.get_vertex(*it);
+    vertex_edge_ids.clear();
+    for (const auto& edge_id : vertex.get_edge_ids()) {
+      const auto [from_vertex_id, to_vertex_id] =
+          graph.get_edge(edge_id).get_binded_vertices();
+      const bool is_from = from_vertex_id == vertex.id;
+      if (!is_selected(is_from ? to_vertex_id : from_vertex_id)) {
+        continue;
+      }
+      vertex_edge_ids.push_back(edge_id);
+      if (is_from) {
+        edge_ids.push_back(edge_id);
+      }
+    }
+    ss_out << print_vertex(vertex, vertex_edge_ids);
+  }
+  ss_out << std::endl << tab_1 << "],\n";
+
+  std::sort(edge_ids.begin(), edge_ids.end());
+  ss_out << tab_1 << "\"edges\": [\n";
+  for (auto it = edge_ids.begin(); it != edge_ids.end(); ++it) {
+    if (it != edge_ids.begin()) {
+      ss_out << ", ";
+    }
+    ss_out << print_edge(graph.get_edge(*it));
+  }
+  ss_out << std::endl << tab_1 << "]\n";
+  ss_out << "}" << std::endl;
+  return ss_out.str();
+}
+
+std::string print_depth_limited(const Graph& graph, const Depth& max_depth) {
+  const auto depth = std::min(max_depth, graph.get_depth());
+  std::vector<VertexId> vertex_ids;
+  for (Depth level = 0; level <= depth; ++level) {
+    const auto& level_vertex_ids = graph.get_vertices_at_depth(level);
+    vertex_ids.insert(vertex_ids.end(), level_vertex_ids.begin(),
+                      level_vertex_ids.end());
+  }
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  return print_subgraph(
+      graph, vertex_ids, depth,
+      [&graph, max_depth](const VertexId& vertex_id) {
+        return graph.get_vertex(vertex_id).depth <= max_depth;
+      });
+}
+
+std::string print_sampled(const Graph& graph,
+                          int sample_size,
+                          unsigned int seed) {
+  // Floyd's sampling over the ids 0..vertices_count-1
+  const int vertices_count = graph.get_vertex_map().size();
+  sample_size = std::min(sample_size, vertices_count);
+  std::mt19937 random_engine(seed);
+  std::unordered_set<VertexId> sample;
+  sample.reserve(sample_size);
+  for (int last = vertices_count - sample_size; last < vertices_count;
+       ++last) {
+    const VertexId vertex_id =
+        std::uniform_int_distribution<VertexId>(0, last)(random_engine);
+    if (!sample.insert(vertex_id).second) {
+      sample.insert(last);
+    }
+  }
+
+  std::vector<VertexId> vertex_ids(sample.begin(), sample.end());
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  Depth max_sampled_depth = 0;
+  for (const auto& vertex_id : vertex_ids) {
+    max_sampled_depth =
+        std::max(max_sampled_depth, graph.get_vertex(vertex_id).depth);
+  }
+  return print_subgraph(graph, vertex_ids, max_sampled_depth,
+                        [&sample](const VertexId& vertex_id) {
+                          return sample.count(vertex_id) > 0;
+                        });
+}
+
+// Edges are counted by Graph::count_edges_of_color(), a pass over the edges
+// per color
+std::string print_summary(const Graph& graph) {
+  std::stringstream ss_out;
+  std::string tab_1 = "    ";
+  ss_out << "{\n";
+  ss_out << tab_1 << "\"depth\": " << graph.get_depth() << ",\n";
+  ss_out << tab_1 << "\"vertices\": " << graph.get_vertex_map().size()
+         << ",\n";
+  ss_out << tab_1 << "\"edges\": " << graph.get_edge_map().size() << ",\n";
+  ss_out << tab_1 << "\"vertices_per_depth\": [";
+  for (Depth depth = 0; depth <= graph.get_depth(); ++depth) {
+    if (depth != 0) {
+      ss_out << ", ";
+    }
+    ss_out << graph.get_vertices_at_depth(depth).size();
+  }
+  ss_out << "],\n";
+  ss_out << tab_1 << "\"edges_per_color\": { ";
+  for (auto it = COLORS.begin(); it != COLORS.end(); ++it) {
+    if (it != COLORS.begin()) {
+      ss_out << ", ";
+    }
+    ss_out << "\"" << color_to_string(*it)
+           << "\": " << graph.count_edges_of_color(*it);
+  }
+  ss_out << " }\n";
+  ss_out << "}" << std::endl;
+  return ss_out.str();
+}
+}  // namespace
+
+namespace uni_cpp_practice {
+std::string GraphPrinter::print() const {
+  switch (level_of_detail_.mode) {
+    case LevelOfDetail::Mode::Full:
+      return print_full(graph_);
+    case LevelOfDetail::Mode::DepthLimited:
+      return print_depth_limited(graph_, level_of_detail_.max_depth);
+    case LevelOfDetail::Mode::Sampled:
+      return print_sampled(graph_, level_of_detail_.sample_size,
+                           level_of_detail_.seed);
+    case LevelOfDetail::Mode::Summary:
+      return print_summary(graph_);
+  }
+  return print_full(graph_);
+}
 }  // namespace uni_cpp_practice
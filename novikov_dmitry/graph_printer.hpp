@@ -4,14 +4,47 @@
 
 namespace uni_cpp_practice {
 
+// Full, the vertices up to max_depth, sample_size random vertices or only
+// the counts per depth and color
+struct LevelOfDetail {
+  enum class Mode { Full, DepthLimited, Sampled, Summary };
+
+  Mode mode = Mode::Full;
+  Depth max_depth = 0;
+  int sample_size = 0;
+  unsigned int seed = 0;
+
+  static LevelOfDetail depth_limited(const Depth& max_depth) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::DepthLimited;
+    level_of_detail.max_depth = max_depth;
+    return level_of_detail;
+  }
+  static LevelOfDetail sampled(int sample_size, unsigned int seed) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Sampled;
+    level_of_detail.sample_size = sample_size;
+    level_of_detail.seed = seed;
+    return level_of_detail;
+  }
+  static LevelOfDetail summary() {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Summary;
+    return level_of_detail;
+  }
+};
+
 class GraphPrinter {
  public:
-  explicit GraphPrinter(const Graph& graph) : graph_(graph){};
+  explicit GraphPrinter(const Graph& graph,
+                        const LevelOfDetail& level_of_detail = LevelOfDetail())
+      : graph_(graph), level_of_detail_(level_of_detail){};
 
   std::string print() const;
 
  private:
   const Graph& graph_;
+  const LevelOfDetail level_of_detail_;
 };
 
 }  // namespace uni_cpp_practice
@@ -0,0 +1,191 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "allocation_profiler.hpp"
+
+#ifndef ALLOCATION_PROFILER
+#define ALLOCATION_PROFILER 0
+#endif
+
+namespace {
+
+using uni_cpp_practice::allocation_profiler::Phase;
+using uni_cpp_practice::allocation_profiler::Recorder;
+
+// Constant-initialized, so operator new may use them while a thread is
+// being started or torn down
+thread_local Recorder* current_recorder = nullptr;
+thread_local Phase current_phase = Phase::Other;
+
+#if ALLOCATION_PROFILER
+
+void* allocate(std::size_t size) {
+  if (current_recorder != nullptr)
+    current_recorder->add_allocation(current_phase, size);
+  if (size == 0)
+    size = 1;
+  while (true) {
+    if (void* const memory = std::malloc(size))
+      return memory;
+    const auto new_handler = std::get_new_handler();
+    if (new_handler == nullptr)
+      throw std::bad_alloc();
+    new_handler();
+  }
+}
+
+void deallocate(void* memory) {
+  if (memory == nullptr)
+    return;
+  if (current_recorder != nullptr)
+    current_recorder->add_deallocation(current_phase);
+  std::free(memory);
+}
+
+#endif
+
+}  // namespace
+
+#if ALLOCATION_PROFILER
+
+// The std::align_val_t overloads are left to the library, nothing in the
+// generator allocates over-aligned types
+
+void* operator new(std::size_t size) {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+void operator delete(void* memory) noexcept {
+  deallocate(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  deallocate(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  deallocate(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+  deallocate(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+  deallocate(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+  deallocate(memory);
+}
+
+#endif
+
+namespace uni_cpp_practice {
+
+namespace allocation_profiler {
+
+bool is_enabled() {
+  return ALLOCATION_PROFILER != 0;
+}
+
+void Recorder::add_allocation(Phase phase, std::size_t bytes) {
+  auto& counters = counters_[static_cast<int>(phase)];
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Recorder::add_deallocation(Phase phase) {
+  counters_[static_cast<int>(phase)].frees_count.fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+PhaseAllocations Recorder::get() const {
+  PhaseAllocations phase_allocations;
+  for (int phase = 0; phase < PHASES_COUNT; ++phase) {
+    const auto& counters = counters_[phase];
+    phase_allocations[phase] = {
+        counters.count.load(std::memory_order_relaxed),
+        counters.bytes.load(std::memory_order_relaxed),
+        counters.frees_count.load(std::memory_order_relaxed)};
+  }
+  return phase_allocations;
+}
+
+Recorder* get_current_recorder() {
+  return current_recorder;
+}
+
+Phase get_current_phase() {
+  return current_phase;
+}
+
+Scope::Scope(Recorder* recorder, Phase phase)
+    : previous_recorder_(current_recorder), previous_phase_(current_phase) {
+  current_recorder = recorder;
+  current_phase = phase;
+}
+
+Scope::~Scope() {
+  current_recorder = previous_recorder_;
+  current_phase = previous_phase_;
+}
+
+Allocations get_total(const PhaseAllocations& phase_allocations) {
+  Allocations total;
+  for (const auto& allocations : phase_allocations) {
+    total.count += allocations.count;
+    total.bytes += allocations.bytes;
+    total.frees_count += allocations.frees_count;
+  }
+  return total;
+}
+
+const char* phase_to_string(Phase phase) {
+  switch (phase) {
+    case Phase::Gray:
+      return "gray";
+    case Phase::Green:
+      return "green";
+    case Phase::Blue:
+      return "blue";
+    case Phase::Yellow:
+      return "yellow";
+    case Phase::Red:
+      return "red";
+    case Phase::Logging:
+      return "logging";
+    case Phase::Json:
+      return "json";
+    case Phase::Other:
+      return "other";
+  }
+  return "";
+}
+
+}  // namespace allocation_profiler
+
+}  // namespace uni_cpp_practice
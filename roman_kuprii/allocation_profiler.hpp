@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace uni_cpp_practice {
+
+namespace allocation_profiler {
+
+// Phases of a graph's job, the painting ones in Edge::Color order
+enum class Phase { Gray, Green, Blue, Yellow, Red, Logging, Json, Other };
+
+constexpr int PHASES_COUNT = 8;
+
+struct Allocations {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t frees_count = 0;
+};
+
+using PhaseAllocations = std::array<Allocations, PHASES_COUNT>;
+
+// The global operator new and delete only count with ALLOCATION_PROFILER=1
+// (see the Makefile), otherwise the phases are tracked but nothing is
+// recorded
+bool is_enabled();
+
+// Allocations of the threads that record into it, thread-safe
+class Recorder {
+ public:
+  Recorder() = default;
+
+  void add_allocation(Phase phase, std::size_t bytes);
+  void add_deallocation(Phase phase);
+  PhaseAllocations get() const;
+
+ private:
+  struct Counters {
+    std::atomic<std::uint64_t> count = 0;
+    std::atomic<std::uint64_t> bytes = 0;
+    std::atomic<std::uint64_t> frees_count = 0;
+  };
+
+  std::array<Counters, PHASES_COUNT> counters_;
+
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+  Recorder(Recorder&&) = delete;
+  Recorder& operator=(Recorder&&) = delete;
+};
+
+// Of the calling thread, nullptr outside any Scope
+Recorder* get_current_recorder();
+Phase get_current_phase();
+
+// Attributes the calling thread's allocations to `recorder` and `phase`
+// until destruction, then restores the previous ones. A new thread has no
+// recorder, so threads started for a phase open their own scope.
+class Scope {
+ public:
+  Scope(Recorder* recorder, Phase phase);
+  // Keeps the current recorder
+  explicit Scope(Phase phase) : Scope(get_current_recorder(), phase) {}
+  ~Scope();
+
+ private:
+  Recorder* previous_recorder_;
+  Phase previous_phase_;
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+  Scope(Scope&&) = delete;
+  Scope& operator=(Scope&&) = delete;
+};
+
+Allocations get_total(const PhaseAllocations& phase_allocations);
+
+const char* phase_to_string(Phase phase);
+
+}  // namespace allocation_profiler
+
+}  // namespace uni_cpp_practice
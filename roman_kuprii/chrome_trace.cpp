@@ -0,0 +1,116 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "chrome_trace.hpp"
+
+namespace {
+
+using Clock = uni_cpp_practice::chrome_trace::Tracer::Clock;
+
+// Threads are numbered in the order they first record something
+std::uint32_t get_thread_id() {
+  static std::atomic<std::uint32_t> threads_count = 0;
+  thread_local const std::uint32_t thread_id = ++threads_count;
+  return thread_id;
+}
+
+double to_microseconds(Clock::duration duration) {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace chrome_trace {
+
+void Tracer::start() {
+  const std::lock_guard lock(mutex_);
+  records_.clear();
+  thread_names_.clear();
+  start_time_ = Clock::now();
+  is_started_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+  is_started_.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::record(const char* name,
+                    Clock::time_point start,
+                    Clock::time_point end,
+                    int graph_index) {
+  if (!is_started())
+    return;
+  const auto thread_id = get_thread_id();
+  const std::lock_guard lock(mutex_);
+  records_.push_back({name, start, end, thread_id, graph_index});
+}
+
+void Tracer::set_thread_name(const std::string& name) {
+  if (!is_started())
+    return;
+  const auto thread_id = get_thread_id();
+  const std::lock_guard lock(mutex_);
+  thread_names_.emplace_back(thread_id, name);
+}
+
+void Tracer::write(const std::string& filename) const {
+  auto file = std::ofstream(filename);
+  if (!file.is_open())
+    throw std::runtime_error("Failed to open " + filename);
+
+  const std::lock_guard lock(mutex_);
+  // Complete events ("X") for the spans, metadata ("M") for thread names
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool is_first = true;
+  const auto write_separator = [&file, &is_first]() {
+    file << (is_first ? "\n" : ",\n");
+    is_first = false;
+  };
+  for (const auto& [thread_id, name] : thread_names_) {
+    write_separator();
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+         << thread_id << ",\"args\":{\"name\":\"" << name << "\"}}";
+  }
+  file << std::fixed << std::setprecision(3);
+  for (const auto& record : records_) {
+    write_separator();
+    file << "{\"name\":\"" << record.name
+         << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.thread_id
+         << ",\"ts\":" << to_microseconds(record.start - start_time_)
+         << ",\"dur\":" << to_microseconds(record.end - record.start);
+    if (record.graph_index >= 0)
+      file << ",\"args\":{\"graph\":" << record.graph_index << '}';
+    file << '}';
+  }
+  file << "\n]}\n";
+
+  if (!file)
+    throw std::runtime_error("Failed to write " + filename);
+}
+
+Span::Span(const char* name, int graph_index)
+    : name_(name),
+      graph_index_(graph_index),
+      is_recording_(Tracer::get_tracer().is_started()) {
+  if (is_recording_)
+    start_ = Clock::now();
+}
+
+void Span::finish() {
+  if (!is_recording_)
+    return;
+  is_recording_ = false;
+  Tracer::get_tracer().record(name_, start_, Clock::now(), graph_index_);
+}
+
+}  // namespace chrome_trace
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uni_cpp_practice {
+
+namespace chrome_trace {
+
+// Spans of the threads written as Chrome trace-event JSON, which Perfetto
+// (ui.perfetto.dev) and about://tracing open. Nothing is recorded until
+// start(), after that every span takes a lock, so spans are kept to a few
+// per graph.
+class Tracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static Tracer& get_tracer() {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  // Forgets the spans recorded before
+  void start();
+  void stop();
+  bool is_started() const {
+    return is_started_.load(std::memory_order_relaxed);
+  }
+
+  // Thread-safe. `name` must outlive the tracer, e.g. be a literal, the
+  // graph index is left out when negative.
+  void record(const char* name,
+              Clock::time_point start,
+              Clock::time_point end,
+              int graph_index = -1);
+
+  // Shown instead of the calling thread's number, only while started
+  void set_thread_name(const std::string& name);
+
+  // Throws std::runtime_error if the file can't be written
+  void write(const std::string& filename) const;
+
+ private:
+  struct Record {
+    const char* name = nullptr;
+    Clock::time_point start;
+    Clock::time_point end;
+    std::uint32_t thread_id = 0;
+    int graph_index = -1;
+  };
+
+  std::atomic<bool> is_started_ = false;
+  mutable std::mutex mutex_;
+  Clock::time_point start_time_;
+  std::vector<Record> records_;
+  std::vector<std::pair<std::uint32_t, std::string>> thread_names_;
+
+  Tracer() = default;
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+  Tracer(Tracer&&) = delete;
+  Tracer& operator=(Tracer&&) = delete;
+};
+
+// Records the time from construction to finish() or destruction. Costs an
+// atomic load when the tracer isn't started.
+class Span {
+ public:
+  explicit Span(const char* name, int graph_index = -1);
+  ~Span() { finish(); }
+
+  void finish();
+  // Nothing is recorded then
+  void discard() { is_recording_ = false; }
+
+ private:
+  const char* name_;
+  int graph_index_;
+  bool is_recording_;
+  Tracer::Clock::time_point start_;
+
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+  Span(Span&&) = delete;
+  Span& operator=(Span&&) = delete;
+};
+
+}  // namespace chrome_trace
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,75 @@
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <string_view>
+
+#include "date_time.hpp"
+
+namespace {
+
+constexpr auto FORMAT = "%Y.%m.%d %H:%M:%S";
+constexpr int MICROSECONDS_DIGITS = 6;
+
+struct CachedDateTime {
+  std::time_t time = -1;
+  std::array<char, 64> buffer;
+  std::size_t datetime_length = 0;
+};
+
+CachedDateTime& get_cached_datetime() {
+  thread_local CachedDateTime cached_datetime;
+  const auto time =
+      std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  if (time != cached_datetime.time) {
+    std::tm local_time;
+    localtime_r(&time, &local_time);
+    cached_datetime.datetime_length =
+        std::strftime(cached_datetime.buffer.data(),
+                      cached_datetime.buffer.size(), FORMAT, &local_time);
+    cached_datetime.time = time;
+  }
+  return cached_datetime;
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace date_time {
+
+std::string_view get_datetime() {
+  const auto& cached_datetime = get_cached_datetime();
+  return {cached_datetime.buffer.data(), cached_datetime.datetime_length};
+}
+
+std::string_view get_precise_datetime() {
+  static const auto start = std::chrono::steady_clock::now();
+  const auto microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  auto& cached_datetime = get_cached_datetime();
+  auto* const begin = cached_datetime.buffer.data();
+  auto* const end = begin + cached_datetime.buffer.size();
+  auto* position = begin + cached_datetime.datetime_length;
+  *position++ = ' ';
+  *position++ = '[';
+  position = std::to_chars(position, end, microseconds / 1000000).ptr;
+  *position++ = '.';
+  // Zero-padded fraction, written from the last digit
+  auto fraction = microseconds % 1000000;
+  for (int digit = MICROSECONDS_DIGITS; digit > 0; --digit) {
+    position[digit - 1] = static_cast<char>('0' + fraction % 10);
+    fraction /= 10;
+  }
+  position += MICROSECONDS_DIGITS;
+  *position++ = ']';
+  return {begin, static_cast<std::size_t>(position - begin)};
+}
+
+}  // namespace date_time
+
+}  // namespace uni_cpp_practice
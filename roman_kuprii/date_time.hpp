@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string_view>
+
+namespace uni_cpp_practice {
+
+namespace date_time {
+
+// Timestamps for log lines. The date and time are formatted with localtime_r
+// at most once a second per thread, other calls reuse the thread's copy. The
+// returned view stays valid until the next call on the same thread.
+
+// "2024.01.31 12:00:00"
+std::string_view get_datetime();
+
+// get_datetime() followed by the monotonic time since the first call in
+// seconds with microseconds: "2024.01.31 12:00:00 [12.345678]"
+std::string_view get_precise_datetime();
+
+}  // namespace date_time
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,176 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "event_trace.hpp"
+#include "graph.hpp"
+
+namespace {
+
+using uni_cpp_practice::event_trace::Event;
+using uni_cpp_practice::event_trace::Header;
+
+// Thread buffers are cached by writer id, addresses could be reused
+std::atomic<std::uint64_t> next_writer_id = 1;
+
+std::uint64_t get_timestamp_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+[[noreturn]] void throw_format_error(const std::string& filename,
+                                     const std::string& message) {
+  throw std::runtime_error("Invalid event trace " + filename + ": " +
+                           message);
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace event_trace {
+
+Event make_started_event(int graph_index) {
+  Event event;
+  event.timestamp_ns = get_timestamp_ns();
+  event.type = EventType::GenerationStarted;
+  event.graph_index = graph_index;
+  return event;
+}
+
+Event make_finished_event(const Graph& graph, int graph_index) {
+  Event event;
+  event.timestamp_ns = get_timestamp_ns();
+  event.type = EventType::GenerationFinished;
+  event.graph_index = graph_index;
+  event.depth = graph.get_depth();
+  event.vertices_num = graph.get_vertices_num();
+  event.edges_num = graph.get_edges_num();
+  for (int color = 0; color < COLORS_COUNT; ++color) {
+    const auto& edge_ids =
+        graph.get_edge_ids_with_color(static_cast<Edge::Color>(color));
+    event.colors_counts[color] = edge_ids.size();
+  }
+  return event;
+}
+
+TraceWriter::TraceWriter(const std::string& filename)
+    : writer_id_(next_writer_id++), filename_(filename) {
+  file_descriptor_ =
+      ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor_ == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  OutputWriter::Options options;
+  options.buffer_size = THREAD_BUFFER_EVENTS * sizeof(Event);
+  options.fsync_policy = OutputWriter::FsyncPolicy::Never;
+  output_writer_.emplace(file_descriptor_, filename_, options);
+
+  Header header;
+  header.event_size = sizeof(Event);
+  output_writer_->submit(std::string_view(
+      reinterpret_cast<const char*>(&header), sizeof(header)));
+}
+
+TraceWriter::~TraceWriter() {
+  if (file_descriptor_ == -1)
+    return;
+  try {
+    close();
+  } catch (const std::runtime_error&) {
+  }
+}
+
+void TraceWriter::record(Event event) {
+  assert(file_descriptor_ != -1 && "Trace is closed");
+  auto& thread_buffer = get_thread_buffer();
+  event.thread_id = thread_buffer.thread_id;
+  thread_buffer.events.push_back(event);
+  if (thread_buffer.events.size() == THREAD_BUFFER_EVENTS)
+    submit(thread_buffer);
+}
+
+void TraceWriter::close() {
+  assert(file_descriptor_ != -1 && "Trace is closed");
+  const int file_descriptor = file_descriptor_;
+  file_descriptor_ = -1;
+  try {
+    for (auto& thread_buffer : thread_buffers_)
+      submit(*thread_buffer);
+    output_writer_->close();
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+  if (::close(file_descriptor) == -1)
+    throw std::runtime_error("Failed to write " + filename_);
+}
+
+TraceWriter::ThreadBuffer& TraceWriter::get_thread_buffer() {
+  // A thread alternating between writers gets a new buffer on every switch
+  thread_local std::uint64_t cached_writer_id = 0;
+  thread_local ThreadBuffer* cached_thread_buffer = nullptr;
+  if (cached_writer_id == writer_id_)
+    return *cached_thread_buffer;
+
+  auto thread_buffer = std::make_unique<ThreadBuffer>();
+  thread_buffer->events.reserve(THREAD_BUFFER_EVENTS);
+  {
+    const std::lock_guard lock(thread_buffers_mutex_);
+    thread_buffer->thread_id = thread_buffers_.size();
+    cached_thread_buffer = thread_buffer.get();
+    thread_buffers_.push_back(std::move(thread_buffer));
+  }
+  cached_writer_id = writer_id_;
+  return *cached_thread_buffer;
+}
+
+void TraceWriter::submit(ThreadBuffer& thread_buffer) {
+  output_writer_->submit(std::string_view(
+      reinterpret_cast<const char*>(thread_buffer.events.data()),
+      thread_buffer.events.size() * sizeof(Event)));
+  thread_buffer.events.clear();
+}
+
+std::vector<Event> read_events(const std::string& filename) {
+  std::ifstream file(filename, std::ifstream::binary | std::ifstream::ate);
+  if (!file.is_open())
+    throw std::runtime_error("Failed to open " + filename);
+  const auto file_size = static_cast<std::size_t>(file.tellg());
+  file.seekg(0);
+
+  Header header;
+  if (file_size < sizeof(header) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    throw_format_error(filename, "too short");
+  if (header.magic != MAGIC)
+    throw_format_error(filename, "bad magic");
+  if (header.version != VERSION)
+    throw_format_error(filename,
+                       "unsupported version " + std::to_string(header.version));
+  if (header.event_size != sizeof(Event))
+    throw_format_error(filename, "unexpected event size");
+  if ((file_size - sizeof(header)) % sizeof(Event) != 0)
+    throw_format_error(filename, "truncated event");
+
+  std::vector<Event> events((file_size - sizeof(header)) / sizeof(Event));
+  if (!file.read(reinterpret_cast<char*>(events.data()),
+                 events.size() * sizeof(Event)))
+    throw std::runtime_error("Failed to read " + filename);
+  return events;
+}
+
+}  // namespace event_trace
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "output_writer.hpp"
+
+namespace uni_cpp_practice {
+
+class Graph;
+
+namespace event_trace {
+
+// Generation events as fixed-size records, native (little-endian) byte
+// order:
+//   Header
+//   Event  events[]  grouped by the recording thread, not sorted by time
+// tools/trace_decode renders them as the log text or CSV.
+constexpr std::array<char, 8> MAGIC = {'R', 'K', 'T', 'R', 'A', 'C', 'E', 0};
+constexpr std::uint32_t VERSION = 1;
+constexpr int COLORS_COUNT = 5;
+
+enum class EventType : std::uint8_t { GenerationStarted, GenerationFinished };
+
+struct Header {
+  std::array<char, 8> magic = MAGIC;
+  std::uint32_t version = VERSION;
+  std::uint32_t event_size = 0;
+};
+
+// Graph fields are zero for GenerationStarted. Only counters the graph
+// keeps are recorded, so making an event takes constant time.
+struct Event {
+  // system_clock time since the epoch
+  std::uint64_t timestamp_ns = 0;
+  std::int32_t graph_index = 0;
+  // Threads are numbered in the order they recorded the first event
+  std::uint32_t thread_id = 0;
+  EventType type = EventType::GenerationStarted;
+  // Pads the event to a cache line
+  std::array<std::uint8_t, 15> reserved = {};
+  std::int32_t depth = 0;
+  std::int32_t vertices_num = 0;
+  std::int32_t edges_num = 0;
+  // Indexed by Edge::Color
+  std::array<std::int32_t, COLORS_COUNT> colors_counts = {};
+};
+
+static_assert(sizeof(Event) == 64, "Event must fill a cache line");
+
+Event make_started_event(int graph_index);
+Event make_finished_event(const Graph& graph, int graph_index);
+
+// record() appends to a buffer of the calling thread, which is handed to an
+// OutputWriter when full, so recording takes no lock in between. Throws
+// std::runtime_error on I/O errors.
+class TraceWriter {
+ public:
+  static constexpr std::size_t THREAD_BUFFER_EVENTS = 1024;
+
+  explicit TraceWriter(const std::string& filename);
+  // Closes the writer if close() wasn't called, errors are lost then
+  ~TraceWriter();
+
+  // Thread-safe, fills in the thread id
+  void record(Event event);
+
+  // Writes the rest of every thread's buffer, the threads that recorded
+  // events must be done with it
+  void close();
+
+ private:
+  struct ThreadBuffer {
+    std::uint32_t thread_id = 0;
+    std::vector<Event> events;
+  };
+
+  const std::uint64_t writer_id_;
+  const std::string filename_;
+  int file_descriptor_ = -1;
+  std::optional<OutputWriter> output_writer_;
+  // Guards the list, each buffer is only touched by its thread
+  std::mutex thread_buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+
+  ThreadBuffer& get_thread_buffer();
+  void submit(ThreadBuffer& thread_buffer);
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+  TraceWriter(TraceWriter&&) = delete;
+  TraceWriter& operator=(TraceWriter&&) = delete;
+};
+
+// Checks the header and the size, throws std::runtime_error otherwise
+std::vector<Event> read_events(const std::string& filename);
+
+}  // namespace event_trace
+
+}  // namespace uni_cpp_practice
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -28,9 +30,26 @@ void Vertex::add_edge_id(const EdgeId& _id) {
   edges_ids_.push_back(_id);
 }
 
+std::vector<EdgeId> Vertex::release_edges_ids() {
+  auto edges_ids = std::move(edges_ids_);
+  edges_ids.clear();
+  return edges_ids;
+}
+
 VertexId Graph::add_vertex() {
   const VertexId new_vertex_id = get_next_vertex_id();
-  vertices_.emplace_back(new_vertex_id);
+  if (spare_edges_ids_.empty()) {
+    vertices_.emplace_back(new_vertex_id);
+  } else {
+    vertices_.emplace_back(new_vertex_id, std::move(spare_edges_ids_.back()));
+    spare_edges_ids_.pop_back();
+  }
+  vertices_.back().reserve_edges_ids(vertex_edges_capacity_);
+  if (new_vertex_id == 0) {
+    if (depth_map_.empty())
+      depth_map_.emplace_back();
+    depth_map_[0].push_back(new_vertex_id);
+  }
   return new_vertex_id;
 }
 
@@ -82,6 +101,9 @@ void Graph::connect_vertices(const VertexId& from_vertex_id,
     }();
     vertices_[to_vertex_id].depth = minimum_depth + 1;
     depth_ = std::max(depth_, minimum_depth + 1);
+    if (static_cast<int>(depth_map_.size()) <= minimum_depth + 1)
+      depth_map_.emplace_back();
+    depth_map_[minimum_depth + 1].push_back(to_vertex_id);
   }
 
   const int diff =
@@ -103,22 +125,88 @@ void Graph::connect_vertices(const VertexId& from_vertex_id,
       return Edge::Color::Gray;
   }();
 
+  add_edge(from_vertex_id, to_vertex_id, color);
+}
+
+VertexId Graph::restore_vertex(int depth) {
+  assert(depth >= 0);
+  const VertexId new_vertex_id = add_vertex();
+  // add_vertex() has already put the root to the first level
+  if (new_vertex_id == 0) {
+    assert(depth == 0);
+    return new_vertex_id;
+  }
+  vertices_[new_vertex_id].depth = depth;
+  while (static_cast<int>(depth_map_.size()) <= depth)
+    depth_map_.emplace_back();
+  depth_map_[depth].push_back(new_vertex_id);
+  depth_ = std::max(depth_, depth);
+  return new_vertex_id;
+}
+
+void Graph::restore_edge(const VertexId& from_vertex_id,
+                         const VertexId& to_vertex_id,
+                         const Edge::Color& color) {
+  // Cheap checks, is_vertex_exist() would make loading quadratic
+  assert(0 <= from_vertex_id && from_vertex_id < get_vertices_num());
+  assert(0 <= to_vertex_id && to_vertex_id < get_vertices_num());
+  add_edge(from_vertex_id, to_vertex_id, color);
+}
+
+void Graph::add_edge(const VertexId& from_vertex_id,
+                     const VertexId& to_vertex_id,
+                     const Edge::Color& color) {
   const auto& new_edge = edges_.emplace_back(from_vertex_id, to_vertex_id,
                                              get_next_edge_id(), color);
   vertices_[from_vertex_id].add_edge_id(new_edge.id);
   if (from_vertex_id != to_vertex_id)
     vertices_[to_vertex_id].add_edge_id(new_edge.id);
+  colored_edge_ids_[static_cast<int>(color)].push_back(new_edge.id);
 }
 
-std::vector<EdgeId> Graph::get_edge_ids_with_color(
-    const Edge::Color& color) const {
-  std::vector<EdgeId> edge_ids;
-  for (const auto& edge : get_edges()) {
-    if (edge.color == color)
-      edge_ids.emplace_back(edge.id);
-  }
+Graph::MemoryUsage Graph::memory_usage() const {
+  MemoryUsage usage;
+  usage.vertices = vertices_.capacity() * sizeof(Vertex);
+  usage.edges = edges_.capacity() * sizeof(Edge);
+
+  usage.adjacency = spare_edges_ids_.capacity() * sizeof(std::vector<EdgeId>);
+  for (const auto& vertex : vertices_)
+    usage.adjacency += vertex.get_edges_ids().capacity() * sizeof(EdgeId);
+  for (const auto& edges_ids : spare_edges_ids_)
+    usage.adjacency += edges_ids.capacity() * sizeof(EdgeId);
+
+  usage.depth_index = depth_map_.capacity() * sizeof(std::vector<VertexId>);
+  for (const auto& vertex_ids : depth_map_)
+    usage.depth_index += vertex_ids.capacity() * sizeof(VertexId);
 
-  return edge_ids;
+  for (const auto& edge_ids : colored_edge_ids_)
+    usage.color_index += edge_ids.capacity() * sizeof(EdgeId);
+  return usage;
+}
+
+void Graph::reserve(int vertices_num, int edges_num) {
+  vertices_.reserve(vertices_num);
+  spare_edges_ids_.reserve(vertices_num);
+  edges_.reserve(edges_num);
+  if (vertices_num > 0)
+    vertex_edges_capacity_ = (2 * edges_num + vertices_num - 1) / vertices_num;
+}
+
+void Graph::reset() {
+  // Reversed, so the next graph's vertex N reuses the list of vertex N
+  for (auto vertex = vertices_.rbegin(); vertex != vertices_.rend();
+       ++vertex) {
+    spare_edges_ids_.push_back(vertex->release_edges_ids());
+  }
+  vertices_.clear();
+  edges_.clear();
+  for (auto& vertex_ids : depth_map_)
+    vertex_ids.clear();
+  for (auto& edge_ids : colored_edge_ids_)
+    edge_ids.clear();
+  depth_ = 0;
+  vertex_id_counter_ = 0;
+  edge_id_counter_ = 0;
 }
 
 }  // namespace uni_cpp_practice
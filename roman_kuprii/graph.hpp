@@ -2,7 +2,9 @@
 
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace uni_cpp_practice {
@@ -32,8 +34,18 @@ struct Vertex {
 
   explicit Vertex(const VertexId& _id) : id_(_id) {}
 
+  // Reuses the capacity of a released edge ids list
+  Vertex(const VertexId& _id, std::vector<EdgeId>&& edges_ids_storage)
+      : id_(_id), edges_ids_(std::move(edges_ids_storage)) {
+    edges_ids_.clear();
+  }
+
   void add_edge_id(const EdgeId& _id);
 
+  void reserve_edges_ids(int edges_num) { edges_ids_.reserve(edges_num); }
+
+  std::vector<EdgeId> release_edges_ids();
+
   const std::vector<EdgeId>& get_edges_ids() const { return edges_ids_; }
 
   const VertexId& get_id() const { return id_; }
@@ -56,6 +68,13 @@ class Graph {
                         const VertexId& to_vertex_id,
                         bool initialization);
 
+  // Rebuild a stored graph: depth and color are taken as given instead of
+  // being derived, ids are assigned in the same order as before
+  VertexId restore_vertex(int depth);
+  void restore_edge(const VertexId& from_vertex_id,
+                    const VertexId& to_vertex_id,
+                    const Edge::Color& color);
+
   const std::vector<Edge>& get_edges() const { return edges_; }
   const std::vector<Vertex>& get_vertices() const { return vertices_; }
 
@@ -63,17 +82,57 @@ class Graph {
   int get_vertices_num() const { return vertices_.size(); }
   int get_edges_num() const { return edges_.size(); }
 
-  std::vector<EdgeId> get_edge_ids_with_color(const Edge::Color& color) const;
+  const std::vector<EdgeId>& get_edge_ids_with_color(
+      const Edge::Color& color) const {
+    return colored_edge_ids_[static_cast<int>(color)];
+  }
+
+  const std::vector<VertexId>& get_vertex_ids_at_depth(int depth) const {
+    assert(depth <= depth_);
+    return depth_map_[depth];
+  }
+
+  // Heap bytes held by the graph, by the structure that holds them
+  struct MemoryUsage {
+    std::size_t vertices = 0;
+    std::size_t edges = 0;
+    std::size_t adjacency = 0;
+    std::size_t depth_index = 0;
+    std::size_t color_index = 0;
+
+    std::size_t total() const {
+      return vertices + edges + adjacency + depth_index + color_index;
+    }
+  };
+
+  MemoryUsage memory_usage() const;
+
+  // Reserves vertices and edges arrays, new vertices get room for the
+  // average number of edges per vertex
+  void reserve(int vertices_num, int edges_num);
+
+  // Removes all vertices and edges, but keeps the allocated memory
+  // (including per-vertex edge ids lists) for the next graph
+  void reset();
 
  private:
   std::vector<Vertex> vertices_;
   std::vector<Edge> edges_;
+  std::vector<std::vector<EdgeId>> spare_edges_ids_;
+  // Levels beyond depth_ are kept empty after reset() for reuse
+  std::vector<std::vector<VertexId>> depth_map_;
+  std::array<std::vector<EdgeId>, 5> colored_edge_ids_;
   int depth_ = 0;
+  int vertex_edges_capacity_ = 0;
   VertexId vertex_id_counter_ = 0;
   EdgeId edge_id_counter_ = 0;
 
   VertexId get_next_vertex_id() { return vertex_id_counter_++; }
   VertexId get_next_edge_id() { return edge_id_counter_++; }
+
+  void add_edge(const VertexId& from_vertex_id,
+                const VertexId& to_vertex_id,
+                const Edge::Color& color);
 };
 
 }  // namespace uni_cpp_practice
@@ -0,0 +1,214 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "graph.hpp"
+#include "graph_archive.hpp"
+#include "graph_printing.hpp"
+#include "graph_reading.hpp"
+
+namespace {
+
+using uni_cpp_practice::graph_archive::Entry;
+using uni_cpp_practice::graph_archive::Footer;
+using uni_cpp_practice::graph_archive::MAGIC;
+
+static_assert(sizeof(Entry) % alignof(std::uint64_t) == 0);
+static_assert(sizeof(Footer) % alignof(std::uint64_t) == 0);
+
+[[noreturn]] void throw_format_error(const std::string& filename,
+                                     const std::string& message) {
+  throw std::runtime_error("Invalid graph archive " + filename + ": " +
+                           message);
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace graph_archive {
+
+ArchiveWriter::ArchiveWriter(const std::string& filename,
+                             OpenMode open_mode,
+                             const OutputWriter::Options& output_options)
+    : filename_(filename), end_offset_(sizeof(MAGIC)) {
+  if (open_mode == OpenMode::Append && ::access(filename.c_str(), F_OK) == 0) {
+    const ArchiveReader reader(filename);
+    entries_ = reader.get_entries();
+    if (!entries_.empty())
+      end_offset_ = entries_.back().offset + entries_.back().length;
+  } else {
+    open_mode = OpenMode::Create;
+  }
+
+  file_descriptor_ = ::open(
+      filename.c_str(),
+      O_WRONLY | O_CREAT | (open_mode == OpenMode::Create ? O_TRUNC : 0),
+      0644);
+  if (file_descriptor_ == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  if (open_mode == OpenMode::Append &&
+      (::ftruncate(file_descriptor_, end_offset_) == -1 ||
+       ::lseek(file_descriptor_, end_offset_, SEEK_SET) == -1)) {
+    ::close(file_descriptor_);
+    throw std::runtime_error("Failed to truncate " + filename);
+  }
+  output_writer_.emplace(file_descriptor_, filename_, output_options);
+  if (open_mode == OpenMode::Create)
+    output_writer_->submit(std::string_view(MAGIC.data(), MAGIC.size()));
+}
+
+ArchiveWriter::~ArchiveWriter() {
+  if (file_descriptor_ == -1)
+    return;
+  try {
+    close();
+  } catch (const std::runtime_error&) {
+  }
+}
+
+void ArchiveWriter::append(int graph_id,
+                           const GraphGenerator::Params& params,
+                           std::uint64_t gray_tree_seed,
+                           const Graph& graph) {
+  json_buffer_.clear();
+  graph_printing::write_graph_json(graph, json_buffer_);
+  append(graph_id, params, gray_tree_seed, json_buffer_);
+}
+
+void ArchiveWriter::append(int graph_id,
+                           const GraphGenerator::Params& params,
+                           std::uint64_t gray_tree_seed,
+                           std::string_view json) {
+  assert(file_descriptor_ != -1 && "Archive is closed");
+  output_writer_->submit(json);
+
+  Entry entry;
+  entry.graph_id = graph_id;
+  entry.depth = params.depth;
+  entry.new_vertices_num = params.new_vertices_num;
+  entry.gray_tree_seed = gray_tree_seed;
+  entry.offset = end_offset_;
+  entry.length = json.size();
+  entries_.push_back(entry);
+  end_offset_ += json.size();
+}
+
+void ArchiveWriter::close() {
+  assert(file_descriptor_ != -1 && "Archive is closed");
+  const int file_descriptor = file_descriptor_;
+  file_descriptor_ = -1;
+
+  Footer footer;
+  footer.index_offset = end_offset_;
+  footer.entries_num = entries_.size();
+  try {
+    output_writer_->submit(
+        std::string_view(reinterpret_cast<const char*>(entries_.data()),
+                         entries_.size() * sizeof(Entry)));
+    output_writer_->submit(std::string_view(
+        reinterpret_cast<const char*>(&footer), sizeof(footer)));
+    output_writer_->close();
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+  if (::close(file_descriptor) == -1)
+    throw std::runtime_error("Failed to write " + filename_);
+}
+
+ArchiveReader::ArchiveReader(const std::string& filename) {
+  const int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (file_descriptor == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  struct stat file_stat;
+  if (::fstat(file_descriptor, &file_stat) == -1) {
+    ::close(file_descriptor);
+    throw std::runtime_error("Failed to stat " + filename);
+  }
+  mapping_size_ = file_stat.st_size;
+  if (mapping_size_ < sizeof(MAGIC) + sizeof(Footer)) {
+    ::close(file_descriptor);
+    throw_format_error(filename, "too short");
+  }
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE,
+                    file_descriptor, 0);
+  ::close(file_descriptor);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw std::runtime_error("Failed to map " + filename);
+  }
+
+  try {
+    data_ = static_cast<const char*>(mapping_);
+    Footer footer;
+    std::memcpy(&footer, data_ + mapping_size_ - sizeof(Footer),
+                sizeof(Footer));
+    if (std::memcmp(data_, MAGIC.data(), MAGIC.size()) != 0 ||
+        footer.magic != MAGIC)
+      throw_format_error(filename, "not a graph archive or not closed");
+    if (footer.version != VERSION)
+      throw_format_error(filename, "unsupported version " +
+                                       std::to_string(footer.version));
+    if (footer.byte_order_mark != BYTE_ORDER_MARK)
+      throw_format_error(filename, "foreign byte order");
+    const std::uint64_t index_end = mapping_size_ - sizeof(Footer);
+    if (footer.index_offset < sizeof(MAGIC) ||
+        footer.index_offset > index_end ||
+        (index_end - footer.index_offset) % sizeof(Entry) != 0 ||
+        (index_end - footer.index_offset) / sizeof(Entry) !=
+            footer.entries_num)
+      throw_format_error(filename, "corrupted index");
+
+    entries_.resize(footer.entries_num);
+    std::memcpy(entries_.data(), data_ + footer.index_offset,
+                index_end - footer.index_offset);
+    // Texts have to follow each other, so appending can continue after the
+    // last one
+    std::uint64_t offset = sizeof(MAGIC);
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+      if (entries_[i].offset != offset ||
+          entries_[i].length > footer.index_offset - offset)
+        throw_format_error(filename, "graph out of place");
+      offset += entries_[i].length;
+      entry_indexes_[entries_[i].graph_id] = i;
+    }
+    if (offset != footer.index_offset)
+      throw_format_error(filename, "graph out of place");
+  } catch (...) {
+    ::munmap(mapping_, mapping_size_);
+    throw;
+  }
+}
+
+ArchiveReader::~ArchiveReader() {
+  if (mapping_ != nullptr)
+    ::munmap(mapping_, mapping_size_);
+}
+
+const Entry* ArchiveReader::find(int graph_id) const {
+  const auto entry_index = entry_indexes_.find(graph_id);
+  if (entry_index == entry_indexes_.end())
+    return nullptr;
+  return &entries_[entry_index->second];
+}
+
+Graph ArchiveReader::read_graph(int graph_id) const {
+  const auto* entry = find(graph_id);
+  if (entry == nullptr)
+    throw std::runtime_error("No graph " + std::to_string(graph_id) +
+                             " in the archive");
+  return graph_reading::graph_from_json(get_json(*entry));
+}
+
+}  // namespace graph_archive
+
+}  // namespace uni_cpp_practice
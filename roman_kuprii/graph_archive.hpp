@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_generator.hpp"
+#include "output_writer.hpp"
+
+namespace uni_cpp_practice {
+
+namespace graph_archive {
+
+// Many graphs in one file, native (little-endian) byte order:
+//   char   magic[8]
+//   graph JSON texts back to back, as graph_printing::write_graph_json()
+//   Entry  index[entries_num]  in the order graphs were appended
+//   Footer
+// Appending overwrites the index and writes a new one after the new graphs.
+constexpr std::array<char, 8> MAGIC = {'R', 'K', 'A', 'R', 'C', 'H', 'V', 0};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Entry {
+  std::int32_t graph_id = 0;
+  std::int32_t depth = 0;
+  std::int32_t new_vertices_num = 0;
+  std::uint32_t reserved = 0;
+  // Of the gray tree structure, see GraphGenerator::get_graph_seed(), the
+  // painted edges aren't reproduced from it
+  std::uint64_t gray_tree_seed = 0;
+
+  // JSON text position in the file
+  std::uint64_t offset = 0;
+  std::uint64_t length = 0;
+};
+
+struct Footer {
+  std::uint64_t index_offset = 0;
+  std::uint64_t entries_num = 0;
+  std::uint32_t version = VERSION;
+  std::uint32_t byte_order_mark = BYTE_ORDER_MARK;
+  std::array<char, 8> magic = MAGIC;
+};
+
+// Not thread-safe, appends have to be serialized by the caller. The file
+// is written by an OutputWriter, so append() doesn't wait for the disk.
+// Throws std::runtime_error on I/O errors and on a broken archive to append
+// to.
+class ArchiveWriter {
+ public:
+  enum class OpenMode { Create, Append };
+
+  explicit ArchiveWriter(
+      const std::string& filename,
+      OpenMode open_mode = OpenMode::Create,
+      const OutputWriter::Options& output_options = OutputWriter::Options());
+  // Writes the index if close() wasn't called, errors are lost then
+  ~ArchiveWriter();
+
+  void append(int graph_id,
+              const GraphGenerator::Params& params,
+              std::uint64_t gray_tree_seed,
+              const Graph& graph);
+  void append(int graph_id,
+              const GraphGenerator::Params& params,
+              std::uint64_t gray_tree_seed,
+              std::string_view json);
+
+  // Writes the index and the footer, the archive is readable after it
+  void close();
+
+  const OutputWriter& get_output_writer() const { return *output_writer_; }
+
+ private:
+  std::string filename_;
+  int file_descriptor_ = -1;
+  std::optional<OutputWriter> output_writer_;
+  std::uint64_t end_offset_ = 0;
+  std::vector<Entry> entries_;
+  // Reused between graphs to avoid reallocating the JSON text
+  std::string json_buffer_;
+
+  ArchiveWriter(const ArchiveWriter&) = delete;
+  ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+  ArchiveWriter(ArchiveWriter&&) = delete;
+  ArchiveWriter& operator=(ArchiveWriter&&) = delete;
+};
+
+// Maps the archive, graph texts are read in place
+class ArchiveReader {
+ public:
+  struct Record {
+    const Entry& entry;
+    std::string_view json;
+  };
+
+  // Sequential access, in the order graphs were appended
+  class Iterator {
+   public:
+    Iterator(const ArchiveReader& reader, std::size_t index)
+        : reader_(&reader), index_(index) {}
+
+    Record operator*() const {
+      const auto& entry = reader_->entries_[index_];
+      return {entry, reader_->get_json(entry)};
+    }
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator!=(const Iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const ArchiveReader* reader_;
+    std::size_t index_;
+  };
+
+  // Checks the footer and that all texts are inside the file, throws
+  // std::runtime_error otherwise
+  explicit ArchiveReader(const std::string& filename);
+  ~ArchiveReader();
+
+  Iterator begin() const { return Iterator(*this, 0); }
+  Iterator end() const { return Iterator(*this, entries_.size()); }
+
+  const std::vector<Entry>& get_entries() const { return entries_; }
+
+  // Random access, the last graph appended with the id or nullptr
+  const Entry* find(int graph_id) const;
+
+  std::string_view get_json(const Entry& entry) const {
+    return std::string_view(data_ + entry.offset, entry.length);
+  }
+
+  // Throws std::runtime_error if there is no such graph
+  Graph read_graph(int graph_id) const;
+
+ private:
+  void* mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  const char* data_ = nullptr;
+  std::vector<Entry> entries_;
+  std::unordered_map<int, std::size_t> entry_indexes_;
+
+  ArchiveReader(const ArchiveReader&) = delete;
+  ArchiveReader& operator=(const ArchiveReader&) = delete;
+  ArchiveReader(ArchiveReader&&) = delete;
+  ArchiveReader& operator=(ArchiveReader&&) = delete;
+};
+
+}  // namespace graph_archive
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,278 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "graph.hpp"
+#include "graph_binary.hpp"
+#include "graph_printing.hpp"
+#include "graph_reading.hpp"
+
+namespace {
+
+using uni_cpp_practice::graph_binary::Header;
+using uni_cpp_practice::graph_binary::SECTION_ALIGNMENT;
+
+static_assert(sizeof(uni_cpp_practice::EdgeId) == sizeof(std::int32_t));
+static_assert(sizeof(uni_cpp_practice::VertexId) == sizeof(std::int32_t));
+static_assert(sizeof(Header) % alignof(std::uint64_t) == 0);
+
+constexpr std::size_t CHUNK_SIZE = 4096;
+constexpr int COLORS_NUM = 5;
+
+std::uint64_t align_offset(std::uint64_t offset) {
+  return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT *
+         SECTION_ALIGNMENT;
+}
+
+// Pads the file up to `offset`, then writes `count` values produced by
+// successive `next_value()` calls through a fixed-size chunk
+template <typename T, typename Generator>
+void write_section(std::ofstream& out,
+                   std::uint64_t offset,
+                   std::size_t count,
+                   const Generator& next_value) {
+  static const std::array<char, SECTION_ALIGNMENT> zeros = {};
+  out.write(zeros.data(), offset - static_cast<std::uint64_t>(out.tellp()));
+
+  std::array<T, CHUNK_SIZE> chunk;
+  while (count > 0) {
+    const std::size_t chunk_size = std::min(count, CHUNK_SIZE);
+    for (std::size_t i = 0; i < chunk_size; ++i)
+      chunk[i] = next_value();
+    out.write(reinterpret_cast<const char*>(chunk.data()),
+              chunk_size * sizeof(T));
+    count -= chunk_size;
+  }
+}
+
+Header make_header(const uni_cpp_practice::Graph& graph) {
+  Header header;
+  header.depth = graph.get_depth();
+  header.vertices_num = graph.get_vertices_num();
+  header.edges_num = graph.get_edges_num();
+  for (const auto& vertex : graph.get_vertices())
+    header.adjacency_size += vertex.get_edges_ids().size();
+
+  std::uint64_t offset = align_offset(sizeof(Header));
+  const auto next_section = [&offset](std::uint64_t size) {
+    const auto section_offset = offset;
+    offset = align_offset(offset + size);
+    return section_offset;
+  };
+  header.depths_offset =
+      next_section(header.vertices_num * sizeof(std::int32_t));
+  header.adjacency_begin_offset =
+      next_section((header.vertices_num + 1) * sizeof(std::uint64_t));
+  header.adjacency_offset =
+      next_section(header.adjacency_size * sizeof(std::int32_t));
+  header.edge_vertices_offset =
+      next_section(2 * header.edges_num * sizeof(std::int32_t));
+  header.edge_colors_offset = offset;
+  header.file_size = offset + header.edges_num * sizeof(std::uint8_t);
+  return header;
+}
+
+[[noreturn]] void throw_format_error(const std::string& filename,
+                                     const std::string& message) {
+  throw std::runtime_error("Invalid graph file " + filename + ": " + message);
+}
+
+// Section of `count` values of T must lie inside the file and be aligned
+template <typename T>
+uni_cpp_practice::graph_binary::ArrayView<T> map_section(
+    const std::string& filename,
+    const char* data,
+    const Header& header,
+    std::uint64_t offset,
+    std::uint64_t count) {
+  if (offset % SECTION_ALIGNMENT != 0 || offset > header.file_size ||
+      count > (header.file_size - offset) / sizeof(T))
+    throw_format_error(filename, "section out of the file");
+  return uni_cpp_practice::graph_binary::ArrayView<T>(
+      reinterpret_cast<const T*>(data + offset), count);
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace graph_binary {
+
+void write_graph_binary(const Graph& graph, const std::string& filename) {
+  std::ofstream out(filename, std::ofstream::binary | std::ofstream::trunc);
+  if (!out.is_open())
+    throw std::runtime_error("Failed to open " + filename);
+
+  const auto header = make_header(graph);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+
+  std::size_t vertex_index = 0;
+  const auto next_depth = [&vertices, &vertex_index]() {
+    return vertices[vertex_index++].depth;
+  };
+  write_section<std::int32_t>(out, header.depths_offset, vertices.size(),
+                              next_depth);
+
+  vertex_index = 0;
+  std::uint64_t adjacency_begin = 0;
+  const auto next_adjacency_begin = [&vertices, &vertex_index,
+                                     &adjacency_begin]() {
+    const auto begin = adjacency_begin;
+    if (vertex_index < vertices.size())
+      adjacency_begin += vertices[vertex_index++].get_edges_ids().size();
+    return begin;
+  };
+  write_section<std::uint64_t>(out, header.adjacency_begin_offset,
+                               vertices.size() + 1, next_adjacency_begin);
+
+  // Walks edge ids of all vertices one after another
+  vertex_index = 0;
+  std::size_t position = 0;
+  const auto next_edge_id = [&vertices, &vertex_index, &position]() {
+    while (position == vertices[vertex_index].get_edges_ids().size()) {
+      ++vertex_index;
+      position = 0;
+    }
+    return vertices[vertex_index].get_edges_ids()[position++];
+  };
+  write_section<std::int32_t>(out, header.adjacency_offset,
+                              header.adjacency_size, next_edge_id);
+
+  std::size_t edge_index = 0;
+  const auto next_edge_vertex_id = [&edges, &edge_index]() {
+    const auto& edge = edges[edge_index / 2];
+    return edge.connected_vertices[edge_index++ % 2];
+  };
+  write_section<std::int32_t>(out, header.edge_vertices_offset,
+                              2 * edges.size(), next_edge_vertex_id);
+
+  edge_index = 0;
+  const auto next_color = [&edges, &edge_index]() {
+    return static_cast<std::uint8_t>(edges[edge_index++].color);
+  };
+  write_section<std::uint8_t>(out, header.edge_colors_offset, edges.size(),
+                              next_color);
+
+  out.close();
+  if (out.fail())
+    throw std::runtime_error("Failed to write " + filename);
+}
+
+GraphView::GraphView(const std::string& filename) {
+  const int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (file_descriptor == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  struct stat file_stat;
+  if (::fstat(file_descriptor, &file_stat) == -1) {
+    ::close(file_descriptor);
+    throw std::runtime_error("Failed to stat " + filename);
+  }
+  mapping_size_ = file_stat.st_size;
+  if (mapping_size_ < sizeof(Header)) {
+    ::close(file_descriptor);
+    throw_format_error(filename, "too short");
+  }
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE,
+                    file_descriptor, 0);
+  ::close(file_descriptor);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw std::runtime_error("Failed to map " + filename);
+  }
+
+  try {
+    const auto* data = static_cast<const char*>(mapping_);
+    header_ = reinterpret_cast<const Header*>(data);
+    const auto& header = *header_;
+    if (header.magic != MAGIC)
+      throw_format_error(filename, "not a graph file");
+    if (header.version != VERSION)
+      throw_format_error(filename, "unsupported version " +
+                                       std::to_string(header.version));
+    if (header.byte_order_mark != BYTE_ORDER_MARK)
+      throw_format_error(filename, "foreign byte order");
+    if (header.file_size != mapping_size_ || header.vertices_num < 0 ||
+        header.edges_num < 0)
+      throw_format_error(filename, "corrupted header");
+
+    depths_ = map_section<std::int32_t>(filename, data, header,
+                                        header.depths_offset,
+                                        header.vertices_num);
+    adjacency_begin_ = map_section<std::uint64_t>(
+        filename, data, header, header.adjacency_begin_offset,
+        header.vertices_num + std::uint64_t(1));
+    adjacency_ = map_section<EdgeId>(filename, data, header,
+                                     header.adjacency_offset,
+                                     header.adjacency_size);
+    edge_vertices_ = map_section<std::int32_t>(
+        filename, data, header, header.edge_vertices_offset,
+        2 * std::uint64_t(header.edges_num));
+    edge_colors_ = map_section<std::uint8_t>(filename, data, header,
+                                             header.edge_colors_offset,
+                                             header.edges_num);
+    // Rows are read without checks, so the offsets are checked once here:
+    // from 0 to adjacency_size, never decreasing
+    if (adjacency_begin_[0] != 0 ||
+        adjacency_begin_[header.vertices_num] != header.adjacency_size)
+      throw_format_error(filename, "corrupted adjacency");
+    for (VertexId vertex_id = 0; vertex_id < header.vertices_num; ++vertex_id)
+      if (adjacency_begin_[vertex_id] > adjacency_begin_[vertex_id + 1])
+        throw_format_error(filename, "corrupted adjacency");
+  } catch (...) {
+    ::munmap(mapping_, mapping_size_);
+    throw;
+  }
+}
+
+GraphView::~GraphView() {
+  if (mapping_ != nullptr)
+    ::munmap(mapping_, mapping_size_);
+}
+
+Graph GraphView::to_graph() const {
+  Graph graph;
+  graph.reserve(get_vertices_num(), get_edges_num());
+  for (const auto& depth : depths_) {
+    if (depth < 0 || (graph.get_vertices_num() == 0 && depth != 0))
+      throw std::runtime_error("Invalid graph file: wrong vertex depth");
+    graph.restore_vertex(depth);
+  }
+  for (EdgeId edge_id = 0; edge_id < get_edges_num(); ++edge_id) {
+    if (edge_colors_[edge_id] >= COLORS_NUM)
+      throw std::runtime_error("Invalid graph file: unknown color");
+    const auto [from_vertex_id, to_vertex_id] = get_edge_vertex_ids(edge_id);
+    if (from_vertex_id < 0 || from_vertex_id >= get_vertices_num() ||
+        to_vertex_id < 0 || to_vertex_id >= get_vertices_num())
+      throw std::runtime_error("Invalid graph file: nonexistent vertex");
+    graph.restore_edge(from_vertex_id, to_vertex_id, get_edge_color(edge_id));
+  }
+  return graph;
+}
+
+void json_to_binary(const std::string& json_filename,
+                    const std::string& binary_filename) {
+  write_graph_binary(graph_reading::read_graph_json(json_filename),
+                     binary_filename);
+}
+
+void binary_to_json(const std::string& binary_filename,
+                    const std::string& json_filename) {
+  graph_printing::write_graph_json_mapped(
+      GraphView(binary_filename).to_graph(), json_filename);
+}
+
+}  // namespace graph_binary
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "graph.hpp"
+
+namespace uni_cpp_practice {
+
+namespace graph_binary {
+
+// File layout, native (little-endian) byte order:
+//   Header
+//   int32  depths[vertices_num]
+//   uint64 adjacency_begin[vertices_num + 1]  CSR row offsets
+//   int32  adjacency[adjacency_size]          edge ids of every vertex
+//   int32  edge_vertices[2 * edges_num]
+//   uint8  edge_colors[edges_num]             Edge::Color values
+// Every section starts at a multiple of SECTION_ALIGNMENT, so a mapped
+// file can be read in place.
+constexpr std::array<char, 8> MAGIC = {'R', 'K', 'G', 'R', 'A', 'P', 'H', 0};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::size_t SECTION_ALIGNMENT = 64;
+
+struct Header {
+  std::array<char, 8> magic = MAGIC;
+  std::uint32_t version = VERSION;
+  std::uint32_t byte_order_mark = BYTE_ORDER_MARK;
+  std::int32_t depth = 0;
+  std::int32_t vertices_num = 0;
+  std::int32_t edges_num = 0;
+  std::uint32_t reserved = 0;
+  std::uint64_t adjacency_size = 0;
+
+  // Offsets from the start of the file
+  std::uint64_t depths_offset = 0;
+  std::uint64_t adjacency_begin_offset = 0;
+  std::uint64_t adjacency_offset = 0;
+  std::uint64_t edge_vertices_offset = 0;
+  std::uint64_t edge_colors_offset = 0;
+  std::uint64_t file_size = 0;
+};
+
+// Read-only view of an array inside the mapped file
+template <typename T>
+class ArrayView {
+ public:
+  ArrayView() = default;
+  ArrayView(const T* data, std::size_t size) : data_(data), size_(size) {}
+
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+  const T* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  const T& operator[](std::size_t index) const { return data_[index]; }
+
+ private:
+  const T* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// Throws std::runtime_error on I/O errors
+void write_graph_binary(const Graph& graph, const std::string& filename);
+
+// Maps a file written by write_graph_binary() and reads it in place,
+// nothing is copied until to_graph() is called
+class GraphView {
+ public:
+  // Checks the header and that all sections are inside the file, throws
+  // std::runtime_error otherwise
+  explicit GraphView(const std::string& filename);
+  ~GraphView();
+
+  int get_depth() const { return header_->depth; }
+  int get_vertices_num() const { return header_->vertices_num; }
+  int get_edges_num() const { return header_->edges_num; }
+
+  ArrayView<std::int32_t> get_depths() const { return depths_; }
+  ArrayView<std::int32_t> get_edge_vertices() const { return edge_vertices_; }
+  ArrayView<std::uint8_t> get_edge_colors() const { return edge_colors_; }
+
+  int get_vertex_depth(const VertexId& vertex_id) const {
+    return depths_[vertex_id];
+  }
+
+  ArrayView<EdgeId> get_vertex_edge_ids(const VertexId& vertex_id) const {
+    const auto begin = adjacency_begin_[vertex_id];
+    return ArrayView<EdgeId>(adjacency_.data() + begin,
+                             adjacency_begin_[vertex_id + 1] - begin);
+  }
+
+  std::array<VertexId, 2> get_edge_vertex_ids(const EdgeId& edge_id) const {
+    return {edge_vertices_[2 * edge_id], edge_vertices_[2 * edge_id + 1]};
+  }
+
+  Edge::Color get_edge_color(const EdgeId& edge_id) const {
+    return static_cast<Edge::Color>(edge_colors_[edge_id]);
+  }
+
+  Graph to_graph() const;
+
+ private:
+  void* mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  const Header* header_ = nullptr;
+  ArrayView<std::int32_t> depths_;
+  ArrayView<std::uint64_t> adjacency_begin_;
+  ArrayView<EdgeId> adjacency_;
+  ArrayView<std::int32_t> edge_vertices_;
+  ArrayView<std::uint8_t> edge_colors_;
+
+  GraphView(const GraphView&) = delete;
+  GraphView& operator=(const GraphView&) = delete;
+  GraphView(GraphView&&) = delete;
+  GraphView& operator=(GraphView&&) = delete;
+};
+
+void json_to_binary(const std::string& json_filename,
+                    const std::string& binary_filename);
+void binary_to_json(const std::string& binary_filename,
+                    const std::string& json_filename);
+
+}  // namespace graph_binary
+
+}  // namespace uni_cpp_practice
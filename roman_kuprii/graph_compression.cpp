@@ -0,0 +1,393 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define HAS_SSSE3_DECODER
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_compression.hpp"
+
+namespace {
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::EdgeId;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::INVALID_ID;
+using uni_cpp_practice::VertexId;
+using uni_cpp_practice::graph_compression::Header;
+
+constexpr int COLORS_NUM = 5;
+constexpr std::size_t SIMD_BLOCK_SIZE = 16;
+constexpr std::array<std::uint32_t, 5> LENGTH_MASKS = {
+    0, 0xff, 0xffff, 0xffffff, 0xffffffff};
+
+[[noreturn]] void throw_format_error(const std::string& message) {
+  throw std::runtime_error("Invalid compressed graph: " + message);
+}
+
+std::uint32_t zigzag_encode(std::int32_t value) {
+  return (static_cast<std::uint32_t>(value) << 1) ^
+         static_cast<std::uint32_t>(value >> 31);
+}
+
+std::int32_t zigzag_decode(std::uint32_t value) {
+  return static_cast<std::int32_t>((value >> 1) ^ (0u - (value & 1)));
+}
+
+int value_length(std::uint32_t value) {
+  if (value < (1u << 8))
+    return 1;
+  if (value < (1u << 16))
+    return 2;
+  if (value < (1u << 24))
+    return 3;
+  return 4;
+}
+
+int value_length(unsigned char control, int position) {
+  return ((control >> (2 * position)) & 3) + 1;
+}
+
+constexpr std::array<unsigned char, 256> make_quad_lengths_table() {
+  std::array<unsigned char, 256> table = {};
+  for (int control = 0; control < 256; ++control)
+    for (int position = 0; position < 4; ++position)
+      table[control] += ((control >> (2 * position)) & 3) + 1;
+  return table;
+}
+
+// Byte indexes that move the values of a quad into 32-bit lanes, 0x80
+// clears the high bytes of shorter values
+constexpr std::array<std::array<unsigned char, SIMD_BLOCK_SIZE>, 256>
+make_shuffle_table() {
+  std::array<std::array<unsigned char, SIMD_BLOCK_SIZE>, 256> table = {};
+  for (int control = 0; control < 256; ++control) {
+    unsigned char byte_index = 0;
+    for (int position = 0; position < 4; ++position) {
+      const int length = ((control >> (2 * position)) & 3) + 1;
+      for (int byte = 0; byte < 4; ++byte)
+        table[control][4 * position + byte] =
+            byte < length ? byte_index++ : 0x80;
+    }
+  }
+  return table;
+}
+
+constexpr auto QUAD_LENGTHS = make_quad_lengths_table();
+constexpr auto SHUFFLE_TABLE = make_shuffle_table();
+
+// Decodes values [begin, count) one by one
+const unsigned char* decode_values(const unsigned char* control,
+                                   const unsigned char* bytes,
+                                   const unsigned char* end,
+                                   std::uint32_t* values,
+                                   std::size_t begin,
+                                   std::size_t count) {
+  for (std::size_t i = begin; i < count; ++i) {
+    const int length = value_length(control[i / 4], i % 4);
+    std::uint32_t value = 0;
+    if (end - bytes >= 4) {
+      std::memcpy(&value, bytes, 4);
+      value &= LENGTH_MASKS[length];
+    } else if (end - bytes >= length) {
+      std::memcpy(&value, bytes, length);
+    } else {
+      throw_format_error("truncated");
+    }
+    values[i] = value;
+    bytes += length;
+  }
+  return bytes;
+}
+
+#ifdef HAS_SSSE3_DECODER
+// Decodes whole quads while a 16-byte load stays inside the data, returns
+// the number of quads decoded
+__attribute__((target("ssse3"))) std::size_t decode_quads_ssse3(
+    const unsigned char* control,
+    std::size_t quads_num,
+    const unsigned char*& bytes,
+    const unsigned char* end,
+    std::uint32_t* values) {
+  std::size_t quad = 0;
+  for (; quad < quads_num &&
+         static_cast<std::size_t>(end - bytes) >= SIMD_BLOCK_SIZE;
+       ++quad) {
+    const __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    const __m128i shuffle = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(SHUFFLE_TABLE[control[quad]].data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + 4 * quad),
+                     _mm_shuffle_epi8(data, shuffle));
+    bytes += QUAD_LENGTHS[control[quad]];
+  }
+  return quad;
+}
+
+bool is_ssse3_supported() {
+  static const bool is_supported = __builtin_cpu_supports("ssse3");
+  return is_supported;
+}
+#endif
+
+// Decodes the next packed array and drops it from `data`
+void decode_array(std::string_view& data,
+                  std::vector<std::uint32_t>& values,
+                  std::size_t count) {
+  // Checked before allocating for a corrupted count
+  if (data.size() < (count + 3) / 4)
+    throw_format_error("truncated");
+  values.resize(count);
+  data.remove_prefix(uni_cpp_practice::graph_compression::decode_integers(
+      data, values.data(), count));
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace graph_compression {
+
+void encode_integers(const std::uint32_t* values,
+                     std::size_t count,
+                     std::string& buffer) {
+  const std::size_t control_begin = buffer.size();
+  buffer.resize(control_begin + (count + 3) / 4, '\0');
+  for (std::size_t i = 0; i < count; ++i) {
+    const int length = value_length(values[i]);
+    buffer[control_begin + i / 4] |= (length - 1) << (2 * (i % 4));
+    std::array<char, 4> bytes;
+    std::memcpy(bytes.data(), &values[i], bytes.size());
+    buffer.append(bytes.data(), length);
+  }
+}
+
+std::size_t decode_integers(std::string_view data,
+                            std::uint32_t* values,
+                            std::size_t count) {
+#ifdef HAS_SSSE3_DECODER
+  if (!is_ssse3_supported())
+    return decode_integers_scalar(data, values, count);
+
+  const std::size_t control_size = (count + 3) / 4;
+  if (data.size() < control_size)
+    throw_format_error("truncated");
+  const auto* control = reinterpret_cast<const unsigned char*>(data.data());
+  const auto* end = control + data.size();
+  const auto* bytes = control + control_size;
+  const std::size_t quads_num =
+      decode_quads_ssse3(control, count / 4, bytes, end, values);
+  bytes = decode_values(control, bytes, end, values, 4 * quads_num, count);
+  return bytes - control;
+#else
+  return decode_integers_scalar(data, values, count);
+#endif
+}
+
+std::size_t decode_integers_scalar(std::string_view data,
+                                   std::uint32_t* values,
+                                   std::size_t count) {
+  const std::size_t control_size = (count + 3) / 4;
+  if (data.size() < control_size)
+    throw_format_error("truncated");
+  const auto* control = reinterpret_cast<const unsigned char*>(data.data());
+  const auto* end = control + data.size();
+  const auto* bytes = decode_values(control, control + control_size, end,
+                                    values, 0, count);
+  return bytes - control;
+}
+
+void compress_graph(const Graph& graph, std::string& buffer) {
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+
+  std::vector<std::uint32_t> color_runs;
+  for (const auto& edge : edges) {
+    const auto color = static_cast<std::uint32_t>(edge.color);
+    if (color_runs.empty() || color_runs[color_runs.size() - 2] != color)
+      color_runs.insert(color_runs.end(), {color, 0});
+    ++color_runs.back();
+  }
+
+  Header header;
+  header.depth = graph.get_depth();
+  header.vertices_num = vertices.size();
+  header.edges_num = edges.size();
+  header.color_runs_num = color_runs.size() / 2;
+  buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<std::uint32_t> values;
+  values.reserve(vertices.size());
+  int previous_depth = 0;
+  for (const auto& vertex : vertices) {
+    values.push_back(zigzag_encode(vertex.depth - previous_depth));
+    previous_depth = vertex.depth;
+  }
+  encode_integers(values.data(), values.size(), buffer);
+
+  std::vector<std::uint32_t> out_edges_counts;
+  std::vector<std::uint32_t> out_edge_ids;
+  std::vector<std::uint32_t> out_edge_ends;
+  out_edges_counts.reserve(vertices.size());
+  out_edge_ids.reserve(edges.size());
+  out_edge_ends.reserve(edges.size());
+  EdgeId previous_first_edge_id = 0;
+  for (const auto& vertex : vertices) {
+    std::uint32_t out_edges_count = 0;
+    EdgeId previous_edge_id = INVALID_ID;
+    // Ids are added in increasing order, so the lists are sorted
+    for (const auto& edge_id : vertex.get_edges_ids()) {
+      const auto& edge = edges[edge_id];
+      if (edge.connected_vertices[0] != vertex.get_id())
+        continue;
+      assert(edge_id > previous_edge_id);
+      if (out_edges_count == 0) {
+        out_edge_ids.push_back(zigzag_encode(edge_id - previous_first_edge_id));
+        previous_first_edge_id = edge_id;
+      } else {
+        out_edge_ids.push_back(edge_id - previous_edge_id);
+      }
+      out_edge_ends.push_back(
+          zigzag_encode(edge.connected_vertices[1] - vertex.get_id()));
+      previous_edge_id = edge_id;
+      ++out_edges_count;
+    }
+    out_edges_counts.push_back(out_edges_count);
+  }
+  encode_integers(out_edges_counts.data(), out_edges_counts.size(), buffer);
+  encode_integers(out_edge_ids.data(), out_edge_ids.size(), buffer);
+  encode_integers(out_edge_ends.data(), out_edge_ends.size(), buffer);
+  encode_integers(color_runs.data(), color_runs.size(), buffer);
+}
+
+Graph decompress_graph(std::string_view data) {
+  Header header;
+  if (data.size() < sizeof(header))
+    throw_format_error("too short");
+  std::memcpy(&header, data.data(), sizeof(header));
+  data.remove_prefix(sizeof(header));
+  if (header.magic != MAGIC)
+    throw_format_error("not a compressed graph");
+  if (header.version != VERSION)
+    throw_format_error("unsupported version " +
+                       std::to_string(header.version));
+  if (header.vertices_num < 0 || header.edges_num < 0 ||
+      header.color_runs_num < 0)
+    throw_format_error("corrupted header");
+  const int vertices_num = header.vertices_num;
+  const int edges_num = header.edges_num;
+
+  // Counts of the header are only trusted once the arrays are decoded
+  std::vector<std::uint32_t> depth_deltas;
+  std::vector<std::uint32_t> out_edges_counts;
+  std::vector<std::uint32_t> out_edge_ids;
+  std::vector<std::uint32_t> out_edge_ends;
+  decode_array(data, depth_deltas, vertices_num);
+  decode_array(data, out_edges_counts, vertices_num);
+  decode_array(data, out_edge_ids, edges_num);
+  decode_array(data, out_edge_ends, edges_num);
+
+  Graph graph;
+  graph.reserve(vertices_num, edges_num);
+  int depth = 0;
+  for (const auto& depth_delta : depth_deltas) {
+    depth += zigzag_decode(depth_delta);
+    if (depth < 0 || (graph.get_vertices_num() == 0 && depth != 0))
+      throw_format_error("wrong vertex depth");
+    graph.restore_vertex(depth);
+  }
+
+  // Edges have to be restored in id order, not in the stored one
+  std::vector<std::array<VertexId, 2>> edge_vertex_ids(
+      edges_num, {INVALID_ID, INVALID_ID});
+  std::uint32_t out_edge_index = 0;
+  EdgeId previous_first_edge_id = 0;
+  for (VertexId vertex_id = 0; vertex_id < vertices_num; ++vertex_id) {
+    if (out_edges_counts[vertex_id] > edges_num - out_edge_index)
+      throw_format_error("too many edges");
+    EdgeId edge_id = INVALID_ID;
+    for (std::uint32_t i = 0; i < out_edges_counts[vertex_id];
+         ++i, ++out_edge_index) {
+      // Sums are computed in 64 bits, so corrupted values can't overflow
+      const std::int64_t next_edge_id =
+          i == 0 ? std::int64_t(previous_first_edge_id) +
+                       zigzag_decode(out_edge_ids[out_edge_index])
+                 : std::int64_t(edge_id) + out_edge_ids[out_edge_index];
+      const std::int64_t end_vertex_id =
+          std::int64_t(vertex_id) +
+          zigzag_decode(out_edge_ends[out_edge_index]);
+      if (next_edge_id <= edge_id || next_edge_id >= edges_num ||
+          edge_vertex_ids[next_edge_id][0] != INVALID_ID)
+        throw_format_error("wrong edge id");
+      if (end_vertex_id < 0 || end_vertex_id >= vertices_num)
+        throw_format_error("nonexistent vertex");
+      edge_id = next_edge_id;
+      if (i == 0)
+        previous_first_edge_id = edge_id;
+      edge_vertex_ids[edge_id] = {vertex_id,
+                                  static_cast<VertexId>(end_vertex_id)};
+    }
+  }
+  if (out_edge_index != static_cast<std::uint32_t>(edges_num))
+    throw_format_error("missing edges");
+
+  std::vector<std::uint32_t> values;
+  decode_array(data, values, 2 * std::size_t(header.color_runs_num));
+  EdgeId edge_id = 0;
+  for (std::size_t run = 0; run < values.size(); run += 2) {
+    const auto color = values[run];
+    const auto run_length = values[run + 1];
+    if (color >= COLORS_NUM)
+      throw_format_error("unknown color");
+    if (run_length > static_cast<std::uint32_t>(edges_num - edge_id))
+      throw_format_error("too many colors");
+    for (std::uint32_t i = 0; i < run_length; ++i, ++edge_id)
+      graph.restore_edge(edge_vertex_ids[edge_id][0],
+                         edge_vertex_ids[edge_id][1],
+                         static_cast<Edge::Color>(color));
+  }
+  if (edge_id != edges_num)
+    throw_format_error("missing colors");
+  if (!data.empty())
+    throw_format_error("trailing bytes");
+  if (graph.get_depth() != header.depth)
+    throw_format_error("wrong depth");
+  return graph;
+}
+
+void write_graph_compressed(const Graph& graph, const std::string& filename) {
+  std::string buffer;
+  compress_graph(graph, buffer);
+  std::ofstream out(filename, std::ofstream::binary | std::ofstream::trunc);
+  if (!out.is_open())
+    throw std::runtime_error("Failed to open " + filename);
+  out.write(buffer.data(), buffer.size());
+  out.close();
+  if (out.fail())
+    throw std::runtime_error("Failed to write " + filename);
+}
+
+Graph read_graph_compressed(const std::string& filename) {
+  std::ifstream in(filename, std::ifstream::binary);
+  if (!in.is_open())
+    throw std::runtime_error("Failed to open " + filename);
+  const std::string data(std::istreambuf_iterator<char>(in), {});
+  if (in.bad())
+    throw std::runtime_error("Failed to read " + filename);
+  return decompress_graph(data);
+}
+
+}  // namespace graph_compression
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "graph.hpp"
+
+namespace uni_cpp_practice {
+
+namespace graph_compression {
+
+// Compressed graph, native (little-endian) byte order:
+//   Header
+//   depths            zigzag(depth - previous depth) for every vertex
+//   out_edges_counts  number of edges starting at every vertex
+//   out_edge_ids      edges starting at a vertex, sorted: the first one as
+//                     zigzag(id - first id of the previous such list), the
+//                     rest as the difference to the previous id
+//   out_edge_ends     zigzag(end vertex id - start vertex id)
+//   color_runs        (color, number of edges) pairs in edge id order
+// Ids are assigned in generation order, so most values fit in a byte.
+// Every array is packed with encode_integers().
+constexpr std::array<char, 4> MAGIC = {'R', 'K', 'G', 'Z'};
+constexpr std::uint32_t VERSION = 1;
+
+struct Header {
+  std::array<char, 4> magic = MAGIC;
+  std::uint32_t version = VERSION;
+  std::int32_t depth = 0;
+  std::int32_t vertices_num = 0;
+  std::int32_t edges_num = 0;
+  std::int32_t color_runs_num = 0;
+};
+
+// Stream VByte: a control byte holds the lengths (1 to 4 bytes) of four
+// values, all control bytes go before the value bytes. Unlike plain varint
+// it needs no branch per byte, and a shuffle decodes four values at once.
+void encode_integers(const std::uint32_t* values,
+                     std::size_t count,
+                     std::string& buffer);
+
+// Decodes `count` values from the beginning of `data` and returns the
+// number of bytes read, throws std::runtime_error if `data` is too short.
+// Uses SSSE3 when the CPU has it.
+std::size_t decode_integers(std::string_view data,
+                            std::uint32_t* values,
+                            std::size_t count);
+// The portable decoder, for comparison
+std::size_t decode_integers_scalar(std::string_view data,
+                                   std::uint32_t* values,
+                                   std::size_t count);
+
+// Appends the compressed graph to `buffer`
+void compress_graph(const Graph& graph, std::string& buffer);
+
+// Throws std::runtime_error on malformed input
+Graph decompress_graph(std::string_view data);
+
+// Throw std::runtime_error on I/O errors
+void write_graph_compressed(const Graph& graph, const std::string& filename);
+Graph read_graph_compressed(const std::string& filename);
+
+}  // namespace graph_compression
+
+}  // namespace uni_cpp_practice
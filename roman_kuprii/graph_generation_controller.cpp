@@ -1,15 +1,76 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <functional>
+#include <iomanip>
 #include <list>
 #include <mutex>
 #include <optional>
 #include <random>
+#include <sstream>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "allocation_profiler.hpp"
+#include "chrome_trace.hpp"
 #include "graph.hpp"
 #include "graph_generation_controller.hpp"
 #include "graph_generator.hpp"
 
+namespace {
+
+using uni_cpp_practice::GraphGenerator;
+using uni_cpp_practice::allocation_profiler::Phase;
+using uni_cpp_practice::chrome_trace::Span;
+using uni_cpp_practice::chrome_trace::Tracer;
+
+// Phase names in Edge::Color order
+constexpr std::array<const char*, 5> PHASE_NAMES = {"gray", "green", "blue",
+                                                    "yellow", "red"};
+constexpr std::array<int, 3> PERCENTILES = {50, 90, 99};
+
+int get_affordable_threads_count(
+    int threads_count,
+    const GraphGenerator& graph_generator,
+    const std::optional<std::size_t>& memory_budget) {
+  if (!memory_budget.has_value())
+    return threads_count;
+  // Every worker holds one graph at a time
+  const auto graph_bytes = std::max<std::size_t>(
+      graph_generator.get_size_estimate().bytes_quantile, 1);
+  const auto affordable_threads_count = memory_budget.value() / graph_bytes;
+  return std::clamp<std::size_t>(affordable_threads_count, 1, threads_count);
+}
+
+void update_peak(std::atomic<std::size_t>& peak, std::size_t value) {
+  auto current_peak = peak.load();
+  while (current_peak < value &&
+         !peak.compare_exchange_weak(current_peak, value)) {
+  }
+}
+
+// Nearest-rank percentiles and the maximum, sorts `times`
+void write_stats_row(std::ostream& stream,
+                     const std::string& phase_name,
+                     std::vector<std::chrono::nanoseconds>& times) {
+  std::sort(times.begin(), times.end());
+  stream << std::left << std::setw(10) << phase_name << std::right;
+  const auto write_time = [&stream](std::chrono::nanoseconds time) {
+    stream << std::setw(12)
+           << std::chrono::duration<double, std::micro>(time).count();
+  };
+  for (const int percentile : PERCENTILES) {
+    const auto rank = (percentile * times.size() + 99) / 100;
+    write_time(times[std::max<std::size_t>(rank, 1) - 1]);
+  }
+  write_time(times.back());
+  stream << std::endl;
+}
+
+}  // namespace
+
 namespace uni_cpp_practice {
 
 namespace graph_generation_controller {
@@ -17,27 +78,40 @@ namespace graph_generation_controller {
 GraphGenerationController::GraphGenerationController(
     int threads_count,
     int graphs_count,
-    const GraphGenerator::Params& graph_generator_params)
-    : graphs_count_(graphs_count), graph_generator_(graph_generator_params) {
-  for (int iter = 0; iter < threads_count; iter++) {
-    workers_.emplace_back(
-        [&jobs_ = jobs_,
-         &get_job_mutex_ = get_job_mutex_]() -> std::optional<JobCallback> {
-          const std::lock_guard lock(get_job_mutex_);
-          if (jobs_.empty()) {
-            return std::nullopt;
-          }
-          const auto job = jobs_.front();
-          jobs_.pop_front();
-          return job;
-        });
+    const GraphGenerator::Params& graph_generator_params,
+    const std::optional<std::size_t>& memory_budget)
+    : graphs_count_(graphs_count),
+      graph_generator_(graph_generator_params),
+      threads_count_(get_affordable_threads_count(threads_count,
+                                                  graph_generator_,
+                                                  memory_budget)),
+      graph_pool_(threads_count_) {
+  jobs_.reserve(graphs_count_);
+  for (int iter = 0; iter < threads_count_; iter++) {
+    workers_.emplace_back([this]() -> std::optional<JobCallback> {
+      const std::lock_guard lock(get_job_mutex_);
+      if (next_job_index_ == jobs_.size()) {
+        return std::nullopt;
+      }
+      return jobs_[next_job_index_++];
+    });
   }
 }
 
 void GraphGenerationController::generate(
     const GenStartedCallback& gen_started_callback,
     const GenFinishedCallback& gen_finished_callback) {
-  std::atomic<int> completed_jobs = 0;
+  const auto start = std::chrono::steady_clock::now();
+  jobs_time_ns_ = 0;
+  peak_memory_usage_ = 0;
+  completed_jobs_ = 0;
+  gen_started_callback_ = &gen_started_callback;
+  gen_finished_callback_ = &gen_finished_callback;
+  // Every job writes only its own element
+  generation_stats_.assign(graphs_count_, {});
+  allocation_recorders_ =
+      std::vector<allocation_profiler::Recorder>(graphs_count_);
+  graph_allocations_.assign(graphs_count_, {});
 
   for (auto& worker : workers_) {
     worker.start();
@@ -45,35 +119,71 @@ void GraphGenerationController::generate(
 
   {
     std::lock_guard lock(get_job_mutex_);
+    jobs_.clear();
+    next_job_index_ = 0;
     for (int i = 0; i < graphs_count_; i++) {
-      jobs_.emplace_back([&gen_started_callback = gen_started_callback,
-                          &gen_finished_callback = gen_finished_callback, i,
-                          &finish_callback_mutex_ = finish_callback_mutex_,
-                          &start_callback_mutex_ = start_callback_mutex_,
-                          &graph_generator_ = graph_generator_,
-                          &completed_jobs = completed_jobs]() {
-        {
-          const std::lock_guard lock(start_callback_mutex_);
-          gen_started_callback(i);
-        }
-
-        auto graph = graph_generator_.generate();
-        {
-          const std::lock_guard lock(finish_callback_mutex_);
-          gen_finished_callback(std::move(graph), i);
-        }
-        completed_jobs++;
-      });
+      jobs_.emplace_back([this, i]() { generate_graph(i); });
     }
   }
-  while (completed_jobs != graphs_count_) {
+  {
+    Tracer::get_tracer().set_thread_name("controller");
+    const auto wait_span = Span("wait for jobs");
+    while (completed_jobs_ != graphs_count_) {
+    }
   }
+  generate_time_ = std::chrono::steady_clock::now() - start;
 
   for (auto& worker : workers_) {
     worker.stop();
   }
 }
 
+void GraphGenerationController::generate_graph(int graph_index) {
+  const auto job_start = std::chrono::steady_clock::now();
+  const auto job_span = Span("job", graph_index);
+  auto& allocation_recorder = allocation_recorders_[graph_index];
+  const auto allocation_scope =
+      allocation_profiler::Scope(&allocation_recorder, Phase::Other);
+  GraphAllocations graph_allocations;
+  {
+    auto lock_span = Span("started callback wait", graph_index);
+    const std::lock_guard lock(start_callback_mutex_);
+    lock_span.finish();
+    const auto callback_span = Span("started callback", graph_index);
+    (*gen_started_callback_)(graph_index);
+  }
+
+  auto& graph = graph_pool_.acquire();
+  // A pooled graph brings the storage it kept, which counts as held too
+  const auto retained_bytes = graph.memory_usage().total();
+  update_peak(peak_memory_usage_, memory_usage_ += retained_bytes);
+  {
+    const auto generate_span = Span("generate", graph_index);
+    generation_stats_[graph_index] =
+        graph_generator_.generate(graph, graph_index);
+  }
+  const auto used_bytes = graph.memory_usage().total();
+  update_peak(peak_memory_usage_,
+              memory_usage_ += used_bytes - retained_bytes);
+  {
+    auto lock_span = Span("finished callback wait", graph_index);
+    const std::lock_guard lock(finish_callback_mutex_);
+    lock_span.finish();
+    const auto callback_span = Span("finished callback", graph_index);
+    (*gen_finished_callback_)(graph, graph_index);
+  }
+  graph_allocations.vertices_num = graph.get_vertices_num();
+  graph_allocations.edges_num = graph.get_edges_num();
+  graph.reset();
+  memory_usage_ -= used_bytes;
+  graph_pool_.release(graph);
+  // Nothing is allocated from here on
+  graph_allocations.phase_allocations = allocation_recorder.get();
+  graph_allocations_[graph_index] = graph_allocations;
+  jobs_time_ns_ += (std::chrono::steady_clock::now() - job_start).count();
+  completed_jobs_++;
+}
+
 GraphGenerationController::Worker::~Worker() {
   if (state_ == State::Working)
     stop();
@@ -84,15 +194,25 @@ void GraphGenerationController::Worker::start() {
   state_ = State::Working;
   thread_ =
       std::thread([&state_ = state_, &get_job_callback_ = get_job_callback_]() {
+        Tracer::get_tracer().set_thread_name("worker");
+        // Polls that find no job are traced as one span
+        std::optional<Span> idle_span;
         while (true) {
           if (state_ == State::ShouldTerminate) {
             state_ = State::Idle;
             return;
           }
+          auto queue_span = Span("queue wait");
           const auto job_optional = get_job_callback_();
-          if (job_optional.has_value()) {
-            job_optional.value()();
+          if (!job_optional.has_value()) {
+            queue_span.discard();
+            if (!idle_span.has_value())
+              idle_span.emplace("idle");
+            continue;
           }
+          queue_span.finish();
+          idle_span.reset();
+          job_optional.value()();
         }
       });
 }
@@ -104,6 +224,89 @@ void GraphGenerationController::Worker::stop() {
     thread_.join();
 }
 
+std::string format_generation_stats(
+    const std::vector<GraphGenerator::GenerationStats>& generation_stats) {
+  std::ostringstream stream;
+  stream << "Generation phases of " << generation_stats.size()
+         << " graphs, us" << std::endl;
+  if (generation_stats.empty())
+    return stream.str();
+
+  stream << std::left << std::setw(10) << "phase" << std::right;
+  for (const int percentile : PERCENTILES)
+    stream << std::setw(12) << "p" + std::to_string(percentile);
+  stream << std::setw(12) << "max" << std::endl;
+  stream << std::fixed << std::setprecision(1);
+
+  std::vector<std::chrono::nanoseconds> times;
+  const auto write_row = [&stream, &generation_stats, &times](
+                             const std::string& phase_name,
+                             const auto& get_time) {
+    times.clear();
+    for (const auto& stats : generation_stats)
+      times.push_back(get_time(stats));
+    write_stats_row(stream, phase_name, times);
+  };
+  for (std::size_t phase = 0; phase < PHASE_NAMES.size(); ++phase)
+    write_row(PHASE_NAMES[phase], [phase](const auto& stats) {
+      return stats.phase_times[phase];
+    });
+  write_row("lock wait",
+            [](const auto& stats) { return stats.lock_wait_time; });
+  write_row("total", [](const auto& stats) { return stats.total_time; });
+  return stream.str();
+}
+
+std::string format_graph_allocations(
+    const std::vector<GraphAllocations>& graph_allocations) {
+  std::ostringstream stream;
+  stream << "Allocations of " << graph_allocations.size()
+         << " graphs by phase" << std::endl;
+  stream << std::setw(8) << "graph" << std::setw(10) << "vertices"
+         << std::setw(10) << "edges";
+  for (int phase = 0; phase < allocation_profiler::PHASES_COUNT; ++phase)
+    stream << std::setw(10)
+           << allocation_profiler::phase_to_string(static_cast<Phase>(phase));
+  stream << std::setw(10) << "total" << std::setw(12) << "bytes"
+         << std::setw(12) << "per vertex" << std::setw(10) << "per edge"
+         << std::endl;
+  stream << std::fixed << std::setprecision(2);
+
+  const auto write_row = [&stream](const std::string& name,
+                                   const GraphAllocations& allocations) {
+    stream << std::setw(8) << name << std::setw(10) << allocations.vertices_num
+           << std::setw(10) << allocations.edges_num;
+    for (const auto& phase_allocations : allocations.phase_allocations)
+      stream << std::setw(10) << phase_allocations.count;
+    const auto total =
+        allocation_profiler::get_total(allocations.phase_allocations);
+    stream << std::setw(10) << total.count << std::setw(12) << total.bytes
+           << std::setw(12)
+           << static_cast<double>(total.count) /
+                  std::max(allocations.vertices_num, 1)
+           << std::setw(10)
+           << static_cast<double>(total.count) /
+                  std::max(allocations.edges_num, 1)
+           << std::endl;
+  };
+  GraphAllocations sum;
+  for (std::size_t graph = 0; graph < graph_allocations.size(); ++graph) {
+    const auto& allocations = graph_allocations[graph];
+    write_row(std::to_string(graph), allocations);
+    sum.vertices_num += allocations.vertices_num;
+    sum.edges_num += allocations.edges_num;
+    for (int phase = 0; phase < allocation_profiler::PHASES_COUNT; ++phase) {
+      auto& phase_sum = sum.phase_allocations[phase];
+      const auto& phase_allocations = allocations.phase_allocations[phase];
+      phase_sum.count += phase_allocations.count;
+      phase_sum.bytes += phase_allocations.bytes;
+      phase_sum.frees_count += phase_allocations.frees_count;
+    }
+  }
+  write_row("total", sum);
+  return stream.str();
+}
+
 }  // namespace graph_generation_controller
 
 }  // namespace uni_cpp_practice
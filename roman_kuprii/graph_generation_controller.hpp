@@ -1,13 +1,20 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include "allocation_profiler.hpp"
 #include "graph_generator.hpp"
+#include "graph_pool.hpp"
 
 namespace uni_cpp_practice {
 
@@ -15,12 +22,20 @@ class Graph;
 
 namespace graph_generation_controller {
 
+// Allocations of a graph's job by phase, only counted when the allocation
+// profiler is built in, with the graph's size to relate them to
+struct GraphAllocations {
+  allocation_profiler::PhaseAllocations phase_allocations = {};
+  int vertices_num = 0;
+  int edges_num = 0;
+};
+
 class GraphGenerationController {
  public:
   using JobCallback = std::function<void()>;
   using GetJobCallback = std::function<std::optional<JobCallback>()>;
   using GenStartedCallback = std::function<void(int)>;
-  using GenFinishedCallback = std::function<void(Graph, int)>;
+  using GenFinishedCallback = std::function<void(const Graph&, int)>;
 
   class Worker {
    public:
@@ -40,24 +55,89 @@ class GraphGenerationController {
     std::atomic<State> state_ = State::Idle;
   };
 
+  // With a memory budget, fewer workers are started if the budget can't
+  // hold a graph per worker (see GraphGenerator::estimate_size)
   GraphGenerationController(
       int threads_count,
       int graphs_count,
-      const GraphGenerator::Params& graph_generator_params);
+      const GraphGenerator::Params& graph_generator_params,
+      const std::optional<std::size_t>& memory_budget = std::nullopt);
+
+  int get_threads_count() const { return threads_count_; }
+
+  // Highest total of Graph::memory_usage() over the graphs held by workers
+  // at the same time during the last generate(). A graph counts from
+  // acquiring it from the pool to releasing it.
+  std::size_t get_peak_memory_usage() const { return peak_memory_usage_; }
+  // Graph::memory_usage() of the reset graphs the pool keeps between
+  // generate() calls
+  std::size_t get_pool_memory_usage() const {
+    return graph_pool_.get_free_memory_usage();
+  }
+
+  // Phase times of the graphs of the last generate(), by graph index
+  const std::vector<GraphGenerator::GenerationStats>& get_generation_stats()
+      const {
+    return generation_stats_;
+  }
+
+  // Wall time of the last generate() and the time its jobs took summed
+  // over the workers. The rest of the workers' time went to polling the
+  // job queue.
+  std::chrono::nanoseconds get_generate_time() const { return generate_time_; }
+  std::chrono::nanoseconds get_jobs_time() const {
+    return std::chrono::nanoseconds(jobs_time_ns_.load());
+  }
+
+  // By graph index, of the last generate(). The callbacks are counted as
+  // Phase::Other unless they open an allocation_profiler::Scope themselves.
+  const std::vector<GraphAllocations>& get_graph_allocations() const {
+    return graph_allocations_;
+  }
 
   void generate(const GenStartedCallback& gen_started_callback,
                 const GenFinishedCallback& gen_finished_callback);
 
  private:
   std::list<Worker> workers_;
-  std::list<JobCallback> jobs_;
+  // A job per graph, refilled by every generate() without reallocating.
+  // The jobs only capture `this` and the graph index, which std::function
+  // stores inline.
+  std::vector<JobCallback> jobs_;
+  std::size_t next_job_index_ = 0;
+  // Of the running generate()
+  const GenStartedCallback* gen_started_callback_ = nullptr;
+  const GenFinishedCallback* gen_finished_callback_ = nullptr;
+  std::atomic<int> completed_jobs_ = 0;
   int graphs_count_;
   GraphGenerator graph_generator_;
+  int threads_count_;
+  GraphPool graph_pool_;
   std::mutex start_callback_mutex_;
   std::mutex finish_callback_mutex_;
   std::mutex get_job_mutex_;
+  // Of the graphs held by workers
+  std::atomic<std::size_t> memory_usage_ = 0;
+  std::atomic<std::size_t> peak_memory_usage_ = 0;
+  std::vector<GraphGenerator::GenerationStats> generation_stats_;
+  std::vector<allocation_profiler::Recorder> allocation_recorders_;
+  std::vector<GraphAllocations> graph_allocations_;
+  std::chrono::nanoseconds generate_time_{0};
+  std::atomic<std::int64_t> jobs_time_ns_ = 0;
+
+  void generate_graph(int graph_index);
 };
 
+// Percentiles of every generation phase over the graphs of a batch, a row
+// per phase in microseconds
+std::string format_generation_stats(
+    const std::vector<GraphGenerator::GenerationStats>& generation_stats);
+
+// A row per graph with the allocations of every phase, the total count and
+// bytes and the allocations per vertex and per edge, then the sums
+std::string format_graph_allocations(
+    const std::vector<GraphAllocations>& graph_allocations);
+
 }  // namespace graph_generation_controller
 
 }  // namespace uni_cpp_practice
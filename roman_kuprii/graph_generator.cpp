@@ -1,69 +1,273 @@
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <functional>
-#include <list>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <random>
 #include <thread>
 #include <vector>
 
+#include "allocation_profiler.hpp"
+#include "chrome_trace.hpp"
 #include "graph.hpp"
 #include "graph_generator.hpp"
+#include "perf_counters.hpp"
+
+namespace uni_cpp_practice {
+
+// Guards the graph and adds up how long threads waited for it. Only a
+// contended lock reads the clock, the free one costs a try_lock.
+class TimedMutex {
+ public:
+  std::unique_lock<std::mutex> lock() {
+    auto mutex_lock = std::unique_lock(mutex_, std::try_to_lock);
+    if (!mutex_lock.owns_lock()) {
+      const auto wait_start = std::chrono::steady_clock::now();
+      mutex_lock.lock();
+      wait_time_ns_.fetch_add(
+          (std::chrono::steady_clock::now() - wait_start).count(),
+          std::memory_order_relaxed);
+    }
+    return mutex_lock;
+  }
+
+  std::chrono::nanoseconds get_wait_time() const {
+    return std::chrono::nanoseconds(
+        wait_time_ns_.load(std::memory_order_relaxed));
+  }
+
+ private:
+  std::mutex mutex_;
+  std::atomic<std::int64_t> wait_time_ns_ = 0;
+};
+
+// Threads kept by a generator for all its graphs, so that generating one
+// neither starts threads nor allocates jobs. run() hands the threads a
+// batch of indexed jobs and works on it too, batches of concurrent calls
+// are taken in turn.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int threads_count) {
+    threads_.reserve(threads_count);
+    for (int i = 0; i < threads_count; ++i)
+      threads_.emplace_back([this]() { work(); });
+  }
+
+  ~ThreadPool() {
+    {
+      const std::lock_guard lock(mutex_);
+      should_stop_ = true;
+    }
+    job_added_.notify_all();
+    for (auto& thread : threads_)
+      thread.join();
+  }
+
+  // Calls job(index) for every index below jobs_count, returns when all
+  // of them did. The batch lives on the caller's stack.
+  template <typename Job>
+  void run(int jobs_count, const Job& job) {
+    auto batch = Batch();
+    batch.call = [](const void* context, int index) {
+      (*static_cast<const Job*>(context))(index);
+    };
+    batch.context = &job;
+    batch.jobs_count = jobs_count;
+    run(batch);
+  }
+
+ private:
+  struct Batch {
+    void (*call)(const void* context, int index) = nullptr;
+    const void* context = nullptr;
+    int jobs_count = 0;
+    // Guarded by mutex_
+    int started_count = 0;
+    int completed_count = 0;
+    Batch* next = nullptr;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable job_added_;
+  std::condition_variable batch_completed_;
+  // Batches with jobs left to start, oldest first
+  Batch* first_batch_ = nullptr;
+  Batch* last_batch_ = nullptr;
+  bool should_stop_ = false;
+  std::vector<std::thread> threads_;
+
+  void run(Batch& batch) {
+    auto lock = std::unique_lock(mutex_);
+    if (batch.jobs_count == 0)
+      return;
+    if (last_batch_ == nullptr)
+      first_batch_ = &batch;
+    else
+      last_batch_->next = &batch;
+    last_batch_ = &batch;
+    job_added_.notify_all();
+    while (batch.started_count < batch.jobs_count)
+      run_job(batch, lock);
+    const auto wait_span = chrome_trace::Span("wait for jobs");
+    batch_completed_.wait(lock, [&batch]() {
+      return batch.completed_count == batch.jobs_count;
+    });
+  }
+
+  void work() {
+    chrome_trace::Tracer::get_tracer().set_thread_name("generator worker");
+    auto lock = std::unique_lock(mutex_);
+    while (true) {
+      job_added_.wait(lock, [this]() {
+        return should_stop_ || first_batch_ != nullptr;
+      });
+      if (should_stop_)
+        return;
+      run_job(*first_batch_, lock);
+    }
+  }
+
+  // Starts the next job of a queued batch with the lock released
+  void run_job(Batch& batch, std::unique_lock<std::mutex>& lock) {
+    const int index = batch.started_count++;
+    if (batch.started_count == batch.jobs_count)
+      remove_batch(batch);
+    lock.unlock();
+    batch.call(batch.context, index);
+    lock.lock();
+    if (++batch.completed_count == batch.jobs_count)
+      batch_completed_.notify_all();
+  }
+
+  void remove_batch(Batch& batch) {
+    Batch* previous = nullptr;
+    for (auto* current = first_batch_; current != &batch;
+         current = current->next)
+      previous = current;
+    (previous == nullptr ? first_batch_ : previous->next) = batch.next;
+    if (last_batch_ == &batch)
+      last_batch_ = previous;
+  }
+};
+
+}  // namespace uni_cpp_practice
 
 namespace {
 
-double get_real_random_number() {
-  std::random_device rd;
-  std::mt19937 gen(rd());
+// Engine streams of a graph's seed
+constexpr std::uint32_t GRAY_BRANCH_STREAM = 0;
+constexpr std::uint32_t PAINT_STREAM = 1;
+
+std::uint64_t mix_bits(std::uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+
+// Fills the engine state with splitmix64 output: std::seed_seq would
+// allocate its vector on every engine
+class SplitMixSeedSequence {
+ public:
+  using result_type = std::uint32_t;
+
+  explicit SplitMixSeedSequence(std::uint64_t state) : state_(state) {}
+
+  template <typename Iterator>
+  void generate(Iterator begin, Iterator end) {
+    for (auto iterator = begin; iterator != end; ++iterator) {
+      state_ += 0x9e3779b97f4a7c15;
+      *iterator = static_cast<result_type>(mix_bits(state_) >> 32);
+    }
+  }
+
+ private:
+  std::uint64_t state_;
+};
+
+std::mt19937 make_engine(const std::optional<std::uint64_t>& graph_seed,
+                         std::uint32_t stream,
+                         int index) {
+  if (!graph_seed.has_value())
+    return std::mt19937(std::random_device()());
+  // The graph seed is mixed first, so that the streams of neighbouring
+  // seeds don't overlap
+  auto seed_sequence = SplitMixSeedSequence(
+      mix_bits(graph_seed.value()) ^
+      (static_cast<std::uint64_t>(stream) << 32 |
+       static_cast<std::uint32_t>(index)));
+  return std::mt19937(seed_sequence);
+}
+
+double get_real_random_number(std::mt19937& engine) {
   std::uniform_real_distribution<> dis(0, 1);
-  return dis(gen);
+  return dis(engine);
 }
 
-int get_int_random_number(int upper_bound) {
-  std::random_device rd;
-  std::mt19937 gen(rd());
+int get_int_random_number(std::mt19937& engine, int upper_bound) {
   std::uniform_int_distribution<> dis(0, upper_bound);
-  return dis(gen);
+  return dis(engine);
 }
 
 constexpr double GREEN_TRASHOULD = 0.1;
 constexpr double BLUE_TRASHOULD = 0.25;
 constexpr double RED_TRASHOULD = 0.33;
 
+// Including the thread calling generate(), which works on its own batches
 constexpr int MAX_THREADS_COUNT = 4;
 
+// Standard normal quantile of the size estimate upper bound (99%)
+constexpr double SIZE_QUANTILE_Z_SCORE = 2.326;
+
 using std::vector;
 
 using uni_cpp_practice::Edge;
 using uni_cpp_practice::Graph;
 using uni_cpp_practice::INVALID_ID;
+using uni_cpp_practice::TimedMutex;
 using uni_cpp_practice::Vertex;
 using uni_cpp_practice::VertexId;
+using uni_cpp_practice::allocation_profiler::Phase;
+using uni_cpp_practice::chrome_trace::Span;
+using uni_cpp_practice::chrome_trace::Tracer;
+using uni_cpp_practice::perf_counters::Counts;
+using uni_cpp_practice::perf_counters::ThreadCounters;
+
+namespace allocation_profiler = uni_cpp_practice::allocation_profiler;
 
-void add_blue_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
+void add_blue_edges(Graph& work_graph,
+                    TimedMutex& add_edge_mutex,
+                    std::mt19937& engine) {
   const int graph_depth = work_graph.get_depth();
+  // Kept by the pool thread, so its capacity is reused by the next graphs
+  thread_local vector<VertexId> uni_depth_vertices_ids;
   for (int current_depth = 1; current_depth <= graph_depth; current_depth++) {
-    vector<Vertex> uni_depth_vertices;
+    uni_depth_vertices_ids.clear();
     for (const auto& vertex : work_graph.get_vertices())
       if (vertex.depth == current_depth)
-        uni_depth_vertices.emplace_back(vertex);
+        uni_depth_vertices_ids.emplace_back(vertex.get_id());
 
     std::array<VertexId, 2> adjacent_vertices = {INVALID_ID, INVALID_ID};
-    for (const auto& vertex : uni_depth_vertices) {
+    for (const auto& vertex_id : uni_depth_vertices_ids) {
       if (adjacent_vertices[0] == INVALID_ID) {
-        adjacent_vertices[0] = vertex.get_id();
+        adjacent_vertices[0] = vertex_id;
       } else if (adjacent_vertices[1] == INVALID_ID) {
-        adjacent_vertices[1] = vertex.get_id();
-        if (get_real_random_number() < BLUE_TRASHOULD) {
-          std::lock_guard lock(add_edge_mutex);
+        adjacent_vertices[1] = vertex_id;
+        if (get_real_random_number(engine) < BLUE_TRASHOULD) {
+          const auto lock = add_edge_mutex.lock();
           work_graph.connect_vertices(adjacent_vertices[0],
                                       adjacent_vertices[1], false);
         }
       } else {
         adjacent_vertices[0] = adjacent_vertices[1];
-        adjacent_vertices[1] = vertex.get_id();
-        if (get_real_random_number() < BLUE_TRASHOULD) {
-          std::lock_guard lock(add_edge_mutex);
+        adjacent_vertices[1] = vertex_id;
+        if (get_real_random_number(engine) < BLUE_TRASHOULD) {
+          const auto lock = add_edge_mutex.lock();
           work_graph.connect_vertices(adjacent_vertices[0],
                                       adjacent_vertices[1], false);
         }
@@ -72,30 +276,35 @@ void add_blue_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
   }
 }
 
-void add_green_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
+void add_green_edges(Graph& work_graph,
+                     TimedMutex& add_edge_mutex,
+                     std::mt19937& engine) {
   for (const auto& start_vertex : work_graph.get_vertices())
-    if (get_real_random_number() < GREEN_TRASHOULD) {
-      std::lock_guard lock(add_edge_mutex);
+    if (get_real_random_number(engine) < GREEN_TRASHOULD) {
+      const auto lock = add_edge_mutex.lock();
       work_graph.connect_vertices(start_vertex.get_id(), start_vertex.get_id(),
                                   false);
     }
 }
 
-void add_red_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
+void add_red_edges(Graph& work_graph,
+                   TimedMutex& add_edge_mutex,
+                   std::mt19937& engine) {
   const int graph_depth = work_graph.get_depth();
+  thread_local vector<VertexId> red_vertices_ids;
   for (const auto& start_vertex : work_graph.get_vertices()) {
-    if (get_real_random_number() < RED_TRASHOULD) {
+    if (get_real_random_number(engine) < RED_TRASHOULD) {
       if (start_vertex.depth + 2 <= graph_depth) {
-        vector<VertexId> red_vertices_ids;
+        red_vertices_ids.clear();
         for (const auto& end_vertex : work_graph.get_vertices()) {
           if (end_vertex.depth == start_vertex.depth + 2)
             red_vertices_ids.emplace_back(end_vertex.get_id());
         }
         if (red_vertices_ids.size() > 0) {
-          std::lock_guard lock(add_edge_mutex);
-          work_graph.connect_vertices(start_vertex.get_id(),
-                                      red_vertices_ids[get_int_random_number(
-                                          red_vertices_ids.size() - 1)],
+          const auto end_vertex_id = red_vertices_ids[get_int_random_number(
+              engine, red_vertices_ids.size() - 1)];
+          const auto lock = add_edge_mutex.lock();
+          work_graph.connect_vertices(start_vertex.get_id(), end_vertex_id,
                                       false);
         }
       }
@@ -103,18 +312,21 @@ void add_red_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
   }
 }
 
-void add_yellow_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
+void add_yellow_edges(Graph& work_graph,
+                      TimedMutex& add_edge_mutex,
+                      std::mt19937& engine) {
   const int graph_depth = work_graph.get_depth();
+  thread_local vector<VertexId> yellow_vertices_ids;
   for (const auto& start_vertex : work_graph.get_vertices()) {
     const double probability = static_cast<double>(start_vertex.depth) /
                                static_cast<double>(graph_depth);
-    if (get_real_random_number() < probability) {
-      vector<VertexId> yellow_vertices_ids;
+    if (get_real_random_number(engine) < probability) {
+      yellow_vertices_ids.clear();
       for (const auto& end_vertex : work_graph.get_vertices()) {
         if (end_vertex.depth == start_vertex.depth + 1) {
           const auto is_connected = [&work_graph, &add_edge_mutex,
                                      &start_vertex, &end_vertex]() {
-            const std::lock_guard lock(add_edge_mutex);
+            const auto lock = add_edge_mutex.lock();
             return work_graph.is_connected(start_vertex.get_id(),
                                            end_vertex.get_id());
           }();
@@ -123,48 +335,29 @@ void add_yellow_edges(Graph& work_graph, std::mutex& add_edge_mutex) {
         }
       }
       if (yellow_vertices_ids.size() > 0) {
-        std::lock_guard lock(add_edge_mutex);
-        work_graph.connect_vertices(start_vertex.get_id(),
-                                    yellow_vertices_ids[get_int_random_number(
-                                        yellow_vertices_ids.size() - 1)],
+        const auto end_vertex_id = yellow_vertices_ids[get_int_random_number(
+            engine, yellow_vertices_ids.size() - 1)];
+        const auto lock = add_edge_mutex.lock();
+        work_graph.connect_vertices(start_vertex.get_id(), end_vertex_id,
                                     false);
       }
     }
   }
 }
 
-void paint_edges(Graph& work_graph) {
-  std::mutex add_edges_mutex;
-  std::thread blue_thread([&work_graph, &add_edges_mutex]() {
-    add_blue_edges(work_graph, add_edges_mutex);
-  });
-  std::thread green_thread([&work_graph, &add_edges_mutex]() {
-    add_green_edges(work_graph, add_edges_mutex);
-  });
-  std::thread red_thread([&work_graph, &add_edges_mutex]() {
-    add_red_edges(work_graph, add_edges_mutex);
-  });
-  std::thread yellow_thread([&work_graph, &add_edges_mutex]() {
-    add_yellow_edges(work_graph, add_edges_mutex);
-  });
-  blue_thread.join();
-  green_thread.join();
-  red_thread.join();
-  yellow_thread.join();
-}
-
 }  // namespace
 
 namespace uni_cpp_practice {
 
 void GraphGenerator::generate_gray_branch(Graph& work_graph,
-                                          std::mutex& graph_mutex,
+                                          TimedMutex& graph_mutex,
                                           const VertexId& parent_vertex_id,
-                                          int current_depth) const {
+                                          int current_depth,
+                                          std::mt19937& engine) const {
   const int depth = params_.depth;
   const VertexId new_vertex_id = [&work_graph, &graph_mutex,
                                   &parent_vertex_id]() {
-    const std::lock_guard lock(graph_mutex);
+    const auto lock = graph_mutex.lock();
     const auto new_vertex_id = work_graph.add_vertex();
     work_graph.connect_vertices(parent_vertex_id, new_vertex_id, true);
     return new_vertex_id;
@@ -177,74 +370,198 @@ void GraphGenerator::generate_gray_branch(Graph& work_graph,
       static_cast<double>(current_depth) / static_cast<double>(depth);
 
   for (int i = 0; i < params_.new_vertices_num; i++) {
-    if (get_real_random_number() > probability) {
+    if (get_real_random_number(engine) > probability) {
       generate_gray_branch(work_graph, graph_mutex, new_vertex_id,
-                           current_depth + 1);
+                           current_depth + 1, engine);
     }
   }
 }
 
 void GraphGenerator::generate_new_vertices(
     Graph& graph,
-    const VertexId& parent_vertex_id) const {
-  std::list<std::function<void()>> jobs;
-  std::atomic<int> completed_jobs = 0;
-  std::mutex graph_mutex;
-  for (int i = 0; i < params_.new_vertices_num; i++)
-    jobs.emplace_back(
-        [this, &graph, &completed_jobs, &graph_mutex, parent_vertex_id]() {
-          generate_gray_branch(graph, graph_mutex, parent_vertex_id, 1);
-          completed_jobs++;
-        });
-
-  std::atomic<bool> should_terminate = false;
-  std::mutex jobs_mutex;
-  auto worker = [&should_terminate, &jobs_mutex, &jobs]() {
-    while (true) {
-      if (should_terminate) {
-        return;
-      }
-      const auto job_optional =
-          [&jobs_mutex, &jobs]() -> std::optional<std::function<void()>> {
-        const std::lock_guard lock(jobs_mutex);
-        if (jobs.empty()) {
-          return std::nullopt;
-        }
-        const auto job = jobs.front();
-        jobs.pop_front();
-        return job;
-      }();
-      if (job_optional.has_value()) {
-        const auto& job = job_optional.value();
-        job();
-      }
-    }
+    TimedMutex& graph_mutex,
+    const VertexId& parent_vertex_id,
+    const std::optional<std::uint64_t>& graph_seed,
+    Counts& gray_counts) const {
+  auto* const allocation_recorder = allocation_profiler::get_current_recorder();
+  std::mutex counts_mutex;
+  // A branch draws from its own engine whichever thread takes it
+  thread_pool_->run(params_.new_vertices_num, [&](int branch_index) {
+    const auto allocation_scope =
+        allocation_profiler::Scope(allocation_recorder, Phase::Gray);
+    const auto branch_span = Span("gray branch");
+    const auto counters = ThreadCounters();
+    auto engine = make_engine(graph_seed, GRAY_BRANCH_STREAM, branch_index);
+    generate_gray_branch(graph, graph_mutex, parent_vertex_id, 1, engine);
+    const auto branch_counts = counters.read();
+    const std::lock_guard lock(counts_mutex);
+    perf_counters::add_counts(gray_counts, branch_counts);
+  });
+}
+
+// Every color is a job with its own engine, their times and counts are
+// stored by Edge::Color
+void GraphGenerator::paint_edges(
+    Graph& graph,
+    TimedMutex& graph_mutex,
+    const std::optional<std::uint64_t>& graph_seed,
+    GenerationStats& stats) const {
+  struct PaintPass {
+    Edge::Color color;
+    const char* span_name;
+    void (*add_edges)(Graph&, TimedMutex&, std::mt19937&);
   };
+  static constexpr std::array<PaintPass, 4> PAINT_PASSES = {{
+      {Edge::Color::Blue, "blue edges", add_blue_edges},
+      {Edge::Color::Green, "green edges", add_green_edges},
+      {Edge::Color::Red, "red edges", add_red_edges},
+      {Edge::Color::Yellow, "yellow edges", add_yellow_edges},
+  }};
+  auto* const allocation_recorder = allocation_profiler::get_current_recorder();
+  thread_pool_->run(static_cast<int>(PAINT_PASSES.size()), [&](int pass_index) {
+    const auto& pass = PAINT_PASSES[pass_index];
+    const int color = static_cast<int>(pass.color);
+    const auto allocation_scope = allocation_profiler::Scope(
+        allocation_recorder, static_cast<Phase>(color));
+    const auto paint_span = Span(pass.span_name);
+    auto engine = make_engine(graph_seed, PAINT_STREAM, color);
+    const auto counters = ThreadCounters();
+    const auto start = std::chrono::steady_clock::now();
+    pass.add_edges(graph, graph_mutex, engine);
+    stats.phase_times[color] = std::chrono::steady_clock::now() - start;
+    stats.phase_counts[color] = counters.read();
+  });
+}
 
-  const auto threads_number =
-      std::min(params_.new_vertices_num, MAX_THREADS_COUNT);
-  auto threads = std::vector<std::thread>();
-  threads.reserve(threads_number);
+GraphGenerator::SizeEstimate GraphGenerator::estimate_size(
+    const Params& params) {
+  const int depth = params.depth;
+  const int new_vertices_num = params.new_vertices_num;
 
-  for (int i = 0; i < threads_number; ++i) {
-    threads.emplace_back(worker);
+  // Vertices per depth form a branching process: the first level is
+  // generated unconditionally, then every vertex at depth d gets
+  // Binomial(new_vertices_num, 1 - d / depth) children
+  vector<double> mean = {1};
+  vector<double> variance = {0};
+  vector<double> growth = {static_cast<double>(new_vertices_num)};
+  if (new_vertices_num > 0) {
+    mean.push_back(new_vertices_num);
+    variance.push_back(0);
+  }
+  for (int current_depth = 1; current_depth < depth && new_vertices_num > 0;
+       current_depth++) {
+    const double probability = 1 - static_cast<double>(current_depth) /
+                                       static_cast<double>(depth);
+    const double children_mean = new_vertices_num * probability;
+    const double children_variance =
+        new_vertices_num * probability * (1 - probability);
+    growth.push_back(children_mean);
+    variance.push_back(children_mean * children_mean * variance.back() +
+                       mean.back() * children_variance);
+    mean.push_back(mean.back() * children_mean);
   }
 
-  while (completed_jobs != params_.new_vertices_num) {
+  SizeEstimate estimate;
+  estimate.vertices_per_depth = mean;
+
+  const int graph_depth = mean.size() - 1;
+  double vertices_variance = 0;
+  for (int from_depth = 0; from_depth <= graph_depth; from_depth++) {
+    vertices_variance += variance[from_depth];
+    // Cov(Z_i, Z_j) = Var(Z_i) * growth_i * ... * growth_(j-1)
+    double covariance_factor = 1;
+    for (int to_depth = from_depth + 1; to_depth <= graph_depth; to_depth++) {
+      covariance_factor *= growth[to_depth - 1];
+      vertices_variance += 2 * variance[from_depth] * covariance_factor;
+    }
   }
 
-  should_terminate = true;
-  for (auto& thread : threads) {
-    thread.join();
+  double vertices = 0;
+  double blue_edges = 0;
+  double yellow_edges = 0;
+  double red_edges = 0;
+  for (int current_depth = 0; current_depth <= graph_depth; current_depth++) {
+    const double level_vertices = mean[current_depth];
+    vertices += level_vertices;
+    if (current_depth > 0)
+      blue_edges += BLUE_TRASHOULD * std::max(level_vertices - 1, 0.0);
+    if (current_depth < graph_depth)
+      yellow_edges += level_vertices * current_depth / graph_depth;
+    if (current_depth + 2 <= graph_depth)
+      red_edges += RED_TRASHOULD * level_vertices;
   }
+
+  auto& edges_per_color = estimate.edges_per_color;
+  edges_per_color[static_cast<int>(Edge::Color::Gray)] = vertices - 1;
+  edges_per_color[static_cast<int>(Edge::Color::Green)] =
+      GREEN_TRASHOULD * vertices;
+  edges_per_color[static_cast<int>(Edge::Color::Blue)] = blue_edges;
+  edges_per_color[static_cast<int>(Edge::Color::Yellow)] = yellow_edges;
+  edges_per_color[static_cast<int>(Edge::Color::Red)] = red_edges;
+
+  estimate.vertices = vertices;
+  for (const auto& color_edges : edges_per_color)
+    estimate.edges += color_edges;
+
+  estimate.vertices_quantile = std::ceil(
+      vertices + SIZE_QUANTILE_Z_SCORE * std::sqrt(vertices_variance));
+  estimate.edges_quantile =
+      std::ceil(estimate.edges * estimate.vertices_quantile / vertices);
+  // Vertex and its depth index entry, edge with two adjacency entries and
+  // its color index entry (see Graph::memory_usage)
+  estimate.bytes_quantile =
+      (sizeof(Vertex) + sizeof(VertexId)) * estimate.vertices_quantile +
+      (sizeof(Edge) + 3 * sizeof(EdgeId)) * estimate.edges_quantile;
+  return estimate;
+}
+
+GraphGenerator::GraphGenerator(const Params& params)
+    : params_(params),
+      size_estimate_(estimate_size(params)),
+      thread_pool_(std::make_unique<ThreadPool>(MAX_THREADS_COUNT - 1)) {}
+
+GraphGenerator::~GraphGenerator() = default;
+
+std::optional<std::uint64_t> GraphGenerator::get_graph_seed(
+    const Params& params,
+    int graph_index) {
+  if (!params.seed.has_value())
+    return std::nullopt;
+  return params.seed.value() + graph_index;
 }
 
 Graph GraphGenerator::generate() const {
   auto graph = Graph();
-  const auto parent_vertex_id = graph.add_vertex();
-  generate_new_vertices(graph, parent_vertex_id);
-  paint_edges(graph);
+  generate(graph);
   return graph;
 }
 
+GraphGenerator::GenerationStats GraphGenerator::generate(
+    Graph& graph,
+    int graph_index) const {
+  assert(graph.get_vertices_num() == 0);
+  const auto graph_seed = get_graph_seed(params_, graph_index);
+  const auto start = std::chrono::steady_clock::now();
+  GenerationStats stats;
+  TimedMutex gray_mutex;
+  {
+    const auto allocation_scope = allocation_profiler::Scope(Phase::Gray);
+    graph.reserve(size_estimate_.vertices_quantile,
+                  size_estimate_.edges_quantile);
+    const auto parent_vertex_id = graph.add_vertex();
+    auto& gray_counts = stats.phase_counts[static_cast<int>(Edge::Color::Gray)];
+    generate_new_vertices(graph, gray_mutex, parent_vertex_id, graph_seed,
+                          gray_counts);
+  }
+  const auto gray_end = std::chrono::steady_clock::now();
+  stats.phase_times[static_cast<int>(Edge::Color::Gray)] = gray_end - start;
+
+  TimedMutex paint_mutex;
+  paint_edges(graph, paint_mutex, graph_seed, stats);
+  stats.lock_wait_time =
+      gray_mutex.get_wait_time() + paint_mutex.get_wait_time();
+  stats.total_time = std::chrono::steady_clock::now() - start;
+  return stats;
+}
+
 }  // namespace uni_cpp_practice
@@ -1,34 +1,107 @@
 #pragma once
 
-#include <mutex>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "graph.hpp"
+#include "perf_counters.hpp"
 
 namespace uni_cpp_practice {
 
-class Graph;
+class ThreadPool;
+class TimedMutex;
 
 class GraphGenerator {
  public:
   struct Params {
-    Params(int _depth, int _new_vertices_num)
-        : depth(_depth), new_vertices_num(_new_vertices_num){};
+    Params(int _depth,
+           int _new_vertices_num,
+           const std::optional<std::uint64_t>& _seed = std::nullopt)
+        : depth(_depth), new_vertices_num(_new_vertices_num), seed(_seed){};
 
     int depth = 0;
     int new_vertices_num = 0;
+    // Of the batch, see get_graph_seed(). Unseeded graphs are drawn from
+    // std::random_device.
+    std::optional<std::uint64_t> seed;
+  };
+
+  // Sizes of graphs generated with given params, derived from the
+  // generation probabilities without generating anything
+  struct SizeEstimate {
+    std::vector<double> vertices_per_depth;
+    double vertices = 0;
+    double edges = 0;
+    std::array<double, 5> edges_per_color = {};
+
+    // ~99th percentile, used to reserve storage and to budget memory
+    int vertices_quantile = 0;
+    int edges_quantile = 0;
+    std::size_t bytes_quantile = 0;
+  };
+
+  // Wall time of the phases of a generate() call: the gray tree, then the
+  // four painting passes, which run in parallel
+  struct GenerationStats {
+    // Indexed by Edge::Color
+    std::array<std::chrono::nanoseconds, 5> phase_times = {};
+    // Summed over the threads, only contended locks are timed
+    std::chrono::nanoseconds lock_wait_time{0};
+    std::chrono::nanoseconds total_time{0};
+    // Hardware counters of the phases, only with perf_counters enabled
+    std::array<perf_counters::Counts, 5> phase_counts = {};
   };
 
+  static SizeEstimate estimate_size(const Params& params);
+
+  // Graph `graph_index` of a seeded batch is generated from seed +
+  // graph_index. Every gray branch and paint pass draws from its own engine
+  // seeded from it, so the seed fixes the shape of the gray tree only: the
+  // parallel branches interleave vertex ids and the paint passes edge ids,
+  // which changes the painted edges. A seed doesn't regenerate its graph
+  // exactly, it makes batches statistically repeatable.
+  static std::optional<std::uint64_t> get_graph_seed(const Params& params,
+                                                     int graph_index);
+
+  // Graph 0 of the batch
   Graph generate() const;
 
-  GraphGenerator(const Params& params) : params_(params) {}
+  // Generates into an empty graph, e.g. one recycled by Graph::reset()
+  GenerationStats generate(Graph& graph, int graph_index = 0) const;
+
+  // Starts the threads that the gray branches and the paint passes of every
+  // generate() call run on, concurrent calls share them
+  GraphGenerator(const Params& params);
+  ~GraphGenerator();
+
+  const SizeEstimate& get_size_estimate() const { return size_estimate_; }
 
  private:
   Params params_;
+  SizeEstimate size_estimate_;
+  std::unique_ptr<ThreadPool> thread_pool_;
 
   void generate_gray_branch(Graph& graph,
-                            std::mutex& graph_mutex,
+                            TimedMutex& graph_mutex,
                             const VertexId& parent_vertex_id,
-                            int current_depth) const;
-  void generate_new_vertices(Graph& graph,
-                             const VertexId& parent_vertex_id) const;
+                            int current_depth,
+                            std::mt19937& engine) const;
+  void generate_new_vertices(
+      Graph& graph,
+      TimedMutex& graph_mutex,
+      const VertexId& parent_vertex_id,
+      const std::optional<std::uint64_t>& graph_seed,
+      perf_counters::Counts& gray_counts) const;
+  void paint_edges(Graph& graph,
+                   TimedMutex& graph_mutex,
+                   const std::optional<std::uint64_t>& graph_seed,
+                   GenerationStats& stats) const;
 };
 
 }  // namespace uni_cpp_practice
@@ -0,0 +1,43 @@
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_pool.hpp"
+
+namespace uni_cpp_practice {
+
+GraphPool::GraphPool(int graphs_count) {
+  graphs_.reserve(graphs_count);
+  free_graphs_.reserve(graphs_count);
+  for (int iter = 0; iter < graphs_count; iter++) {
+    free_graphs_.push_back(
+        graphs_.emplace_back(std::make_unique<Graph>()).get());
+  }
+}
+
+Graph& GraphPool::acquire() {
+  const std::lock_guard lock(mutex_);
+  if (free_graphs_.empty()) {
+    return *graphs_.emplace_back(std::make_unique<Graph>());
+  }
+  auto* const graph = free_graphs_.back();
+  free_graphs_.pop_back();
+  return *graph;
+}
+
+void GraphPool::release(Graph& graph) {
+  const std::lock_guard lock(mutex_);
+  free_graphs_.push_back(&graph);
+}
+
+std::size_t GraphPool::get_free_memory_usage() const {
+  const std::lock_guard lock(mutex_);
+  std::size_t memory_usage = 0;
+  for (const auto* graph : free_graphs_)
+    memory_usage += graph->memory_usage().total();
+  return memory_usage;
+}
+
+}  // namespace uni_cpp_practice
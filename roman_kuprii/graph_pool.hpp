@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uni_cpp_practice {
+
+class Graph;
+
+// Keeps generated graphs for reuse, so that a batch of same-sized graphs
+// stops reallocating vertices, edges and adjacency lists after warm-up
+class GraphPool {
+ public:
+  explicit GraphPool(int graphs_count);
+
+  Graph& acquire();
+  // The graph must have been reset
+  void release(Graph& graph);
+
+  // Graph::memory_usage() summed over the graphs waiting in the pool, the
+  // storage they keep for their next use
+  std::size_t get_free_memory_usage() const;
+
+ private:
+  std::vector<std::unique_ptr<Graph>> graphs_;
+  std::vector<Graph*> free_graphs_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace uni_cpp_practice
@@ -1,10 +1,17 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <array>
-#include <fstream>
-#include <iomanip>
-#include <iostream>
-#include <memory>
-#include <sstream>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "graph.hpp"
@@ -12,16 +19,75 @@
 
 namespace {
 
-using std::to_string;
-using std::vector;
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::Vertex;
 
-}  // namespace
+// Enough for any int including the sign
+constexpr int MAX_NUMBER_LENGTH = 11;
 
-namespace uni_cpp_practice {
+// Every piece of text is listed once, so the size computation can't get
+// out of sync with rendering
+constexpr std::string_view GRAPH_BEGIN = "{ \"depth\": ";
+constexpr std::string_view VERTICES_BEGIN = ", \"vertices\": [ ";
+constexpr std::string_view VERTICES_END_EDGES_BEGIN = " ], \"edges\": [ ";
+constexpr std::string_view GRAPH_END = " ] }\n";
+constexpr std::string_view SEPARATOR = ", ";
+constexpr std::string_view ID_BEGIN = "{ \"id\": ";
+constexpr std::string_view EDGE_IDS_BEGIN = ", \"edge_ids\": [";
+constexpr std::string_view VERTEX_END = "] }";
+constexpr std::string_view VERTEX_IDS_BEGIN = ", \"vertex_ids\": [";
+constexpr std::string_view COLOR_BEGIN = "], \"color\": ";
+constexpr std::string_view EDGE_END = " }";
 
-namespace graph_printing {
+// Renders into memory of a size known beforehand (see graph_json_size()),
+// without the capacity checks of std::string
+class MemoryOutput {
+ public:
+  MemoryOutput(char* begin, char* end) : position_(begin), end_(end) {}
 
-std::string color_to_string(const Edge::Color& color) {
+  MemoryOutput& operator+=(std::string_view text) {
+    assert(text.size() <= static_cast<std::size_t>(end_ - position_));
+    std::memcpy(position_, text.data(), text.size());
+    position_ += text.size();
+    return *this;
+  }
+
+  void append_number(int number) {
+    const auto result = std::to_chars(position_, end_, number);
+    assert(result.ec == std::errc());
+    position_ = result.ptr;
+  }
+
+  char* get_position() const { return position_; }
+
+ private:
+  char* position_;
+  char* const end_;
+};
+
+void append_number(std::string& buffer, int number) {
+  std::array<char, MAX_NUMBER_LENGTH> digits;
+  const auto result =
+      std::to_chars(digits.data(), digits.data() + digits.size(), number);
+  buffer.append(digits.data(), result.ptr);
+}
+
+void append_number(MemoryOutput& output, int number) {
+  output.append_number(number);
+}
+
+std::size_t number_length(int number) {
+  std::size_t length = number < 0 ? 2 : 1;
+  unsigned int magnitude = number < 0 ? 0u - number : number;
+  while (magnitude >= 10) {
+    magnitude /= 10;
+    ++length;
+  }
+  return length;
+}
+
+std::string_view color_to_json(const Edge::Color& color) {
   switch (color) {
     case Edge::Color::Gray:
       return "\"gray\"";
@@ -34,61 +100,273 @@ std::string color_to_string(const Edge::Color& color) {
     case Edge::Color::Red:
       return "\"red\"";
   }
+  return "";
+}
+
+// `Output` is std::string or MemoryOutput
+
+template <typename Output>
+void write_vertex(const Vertex& vertex, Output& output) {
+  output += ID_BEGIN;
+  append_number(output, vertex.get_id());
+  output += EDGE_IDS_BEGIN;
+  bool is_first = true;
+  for (const auto& edge_id : vertex.get_edges_ids()) {
+    if (!is_first)
+      output += SEPARATOR;
+    is_first = false;
+    append_number(output, edge_id);
+  }
+  output += VERTEX_END;
+}
+
+template <typename Output>
+void write_edge(const Edge& edge, Output& output) {
+  output += ID_BEGIN;
+  append_number(output, edge.id);
+  output += VERTEX_IDS_BEGIN;
+  append_number(output, edge.connected_vertices[0]);
+  output += SEPARATOR;
+  append_number(output, edge.connected_vertices[1]);
+  output += COLOR_BEGIN;
+  output += color_to_json(edge.color);
+  output += EDGE_END;
+}
+
+template <typename Output>
+void write_graph_begin(const Graph& graph, Output& output) {
+  output += GRAPH_BEGIN;
+  append_number(output, graph.get_depth());
+  output += VERTICES_BEGIN;
+}
+
+// Elements [begin, end) of a list, separated as if the whole list was
+// written, so parts written separately can be concatenated
+template <typename Element, typename WriteElement, typename Output>
+void write_list_part(const std::vector<Element>& elements,
+                     std::size_t begin,
+                     std::size_t end,
+                     const WriteElement& write_element,
+                     Output& output) {
+  for (std::size_t i = begin; i < end; ++i) {
+    if (i != 0)
+      output += SEPARATOR;
+    write_element(elements[i], output);
+  }
+}
+
+template <typename Output>
+void write_graph(const Graph& graph, Output& output) {
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+  write_graph_begin(graph, output);
+  write_list_part(vertices, 0, vertices.size(), write_vertex<Output>, output);
+  output += VERTICES_END_EDGES_BEGIN;
+  write_list_part(edges, 0, edges.size(), write_edge<Output>, output);
+  output += GRAPH_END;
+}
+
+// Length of a list of `count` elements, given their total length
+std::size_t list_length(std::size_t count, std::size_t elements_length) {
+  return elements_length + (count > 0 ? (count - 1) * SEPARATOR.size() : 0);
+}
+
+std::size_t vertex_json_size(const Vertex& vertex) {
+  const auto& edge_ids = vertex.get_edges_ids();
+  std::size_t edge_ids_length = 0;
+  for (const auto& edge_id : edge_ids)
+    edge_ids_length += number_length(edge_id);
+  return ID_BEGIN.size() + number_length(vertex.get_id()) +
+         EDGE_IDS_BEGIN.size() + list_length(edge_ids.size(), edge_ids_length) +
+         VERTEX_END.size();
+}
+
+std::size_t edge_json_size(const Edge& edge) {
+  return ID_BEGIN.size() + number_length(edge.id) + VERTEX_IDS_BEGIN.size() +
+         number_length(edge.connected_vertices[0]) + SEPARATOR.size() +
+         number_length(edge.connected_vertices[1]) + COLOR_BEGIN.size() +
+         color_to_json(edge.color).size() + EDGE_END.size();
+}
+
+// Runs `job(thread_index)` for every index, the first one on this thread
+template <typename Job>
+void run_in_threads(int threads_count, const Job& job) {
+  std::vector<std::thread> threads;
+  threads.reserve(threads_count - 1);
+  for (int thread_index = 1; thread_index < threads_count; ++thread_index)
+    threads.emplace_back(job, thread_index);
+  job(0);
+  for (auto& thread : threads)
+    thread.join();
+}
+
+bool write_at(int file_descriptor, std::string_view data, off_t offset) {
+  while (!data.empty()) {
+    const auto written =
+        ::pwrite(file_descriptor, data.data(), data.size(), offset);
+    if (written == -1) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data.remove_prefix(written);
+    offset += written;
+  }
+  return true;
+}
+
+// Reserves the file blocks up front where the file system can, otherwise
+// only sets the size
+bool allocate_file(int file_descriptor, std::size_t size) {
+  const int error = ::posix_fallocate(file_descriptor, 0, size);
+  if (error == 0)
+    return true;
+  if (error != EOPNOTSUPP && error != EINVAL)
+    return false;
+  return ::ftruncate(file_descriptor, size) == 0;
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace graph_printing {
+
+std::string color_to_string(const Edge::Color& color) {
+  return std::string(color_to_json(color));
+}
+
+void write_edge_json(const Edge& edge, std::string& buffer) {
+  write_edge(edge, buffer);
+}
+
+void write_vertex_json(const Vertex& vertex, std::string& buffer) {
+  write_vertex(vertex, buffer);
+}
+
+void write_graph_json(const Graph& graph, std::string& buffer) {
+  const std::size_t begin = buffer.size();
+  buffer.resize(begin + graph_json_size(graph));
+  auto output = MemoryOutput(buffer.data() + begin,
+                             buffer.data() + buffer.size());
+  write_graph(graph, output);
+  assert(output.get_position() == buffer.data() + buffer.size());
+}
+
+std::size_t graph_json_size(const Graph& graph) {
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+  std::size_t vertices_length = 0;
+  for (const auto& vertex : vertices)
+    vertices_length += vertex_json_size(vertex);
+  std::size_t edges_length = 0;
+  for (const auto& edge : edges)
+    edges_length += edge_json_size(edge);
+  return GRAPH_BEGIN.size() + number_length(graph.get_depth()) +
+         VERTICES_BEGIN.size() + list_length(vertices.size(), vertices_length) +
+         VERTICES_END_EDGES_BEGIN.size() +
+         list_length(edges.size(), edges_length) + GRAPH_END.size();
+}
+
+void write_graph_json_mapped(const Graph& graph, const std::string& filename) {
+  const std::size_t size = graph_json_size(graph);
+  const int file_descriptor =
+      ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  if (!allocate_file(file_descriptor, size)) {
+    ::close(file_descriptor);
+    throw std::runtime_error("Failed to allocate " + filename);
+  }
+  void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         file_descriptor, 0);
+  if (mapping == MAP_FAILED) {
+    ::close(file_descriptor);
+    throw std::runtime_error("Failed to map " + filename);
+  }
+
+  auto* data = static_cast<char*>(mapping);
+  auto output = MemoryOutput(data, data + size);
+  write_graph(graph, output);
+  assert(output.get_position() == data + size);
+
+  const bool is_unmapped = ::munmap(mapping, size) == 0;
+  if (::close(file_descriptor) == -1 || !is_unmapped)
+    throw std::runtime_error("Failed to write " + filename);
+}
+
+void write_graph_json_file(const Graph& graph,
+                           const std::string& filename,
+                           int threads_count) {
+  assert(threads_count > 0);
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+
+  // In file order: beginning, vertices parts, middle, edges parts, end
+  std::vector<std::string> parts(2 * threads_count + 3);
+  const auto vertices_part_index = [](int thread_index) {
+    return 1 + thread_index;
+  };
+  const auto edges_part_index = [threads_count](int thread_index) {
+    return threads_count + 2 + thread_index;
+  };
+  write_graph_begin(graph, parts.front());
+  parts[threads_count + 1] = VERTICES_END_EDGES_BEGIN;
+  parts.back() = GRAPH_END;
+
+  // Equal numbers of elements, that is roughly equal numbers of bytes
+  const auto part_begin = [threads_count](std::size_t size, int part_num) {
+    return size * part_num / threads_count;
+  };
+  run_in_threads(threads_count, [&](int thread_index) {
+    write_list_part(vertices, part_begin(vertices.size(), thread_index),
+                    part_begin(vertices.size(), thread_index + 1),
+                    write_vertex<std::string>,
+                    parts[vertices_part_index(thread_index)]);
+    write_list_part(edges, part_begin(edges.size(), thread_index),
+                    part_begin(edges.size(), thread_index + 1),
+                    write_edge<std::string>,
+                    parts[edges_part_index(thread_index)]);
+  });
+
+  std::vector<off_t> offsets(parts.size() + 1, 0);
+  for (std::size_t i = 0; i < parts.size(); ++i)
+    offsets[i + 1] = offsets[i] + parts[i].size();
+
+  const int file_descriptor =
+      ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  std::atomic<bool> is_failed = false;
+  run_in_threads(threads_count, [&](int thread_index) {
+    std::vector<int> part_indexes = {vertices_part_index(thread_index),
+                                     edges_part_index(thread_index)};
+    if (thread_index == 0)
+      part_indexes.insert(part_indexes.end(), {0, threads_count + 1,
+                                               2 * threads_count + 2});
+    for (const auto& part_index : part_indexes)
+      if (!write_at(file_descriptor, parts[part_index], offsets[part_index]))
+        is_failed = true;
+  });
+  if (::close(file_descriptor) == -1 || is_failed)
+    throw std::runtime_error("Failed to write " + filename);
 }
 
 std::string edge_to_json(const Edge& edge) {
   std::string res;
-  res = "{ \"id\": ";
-  res += to_string(edge.id);
-  res += ", \"vertex_ids\": [";
-  res += to_string(edge.connected_vertices[0]);
-  res += ", ";
-  res += to_string(edge.connected_vertices[1]);
-  res += "], \"color\": ";
-  res += color_to_string(edge.color);
-  res += " }";
+  write_edge_json(edge, res);
   return res;
 }
 
 std::string vertex_to_json(const Vertex& vertex) {
   std::string res;
-  res = "{ \"id\": ";
-  res += to_string(vertex.get_id()) + ", \"edge_ids\": [";
-  for (const auto& edge_id : vertex.get_edges_ids()) {
-    res += to_string(edge_id);
-    res += ", ";
-  }
-  if (vertex.get_edges_ids().size() > 0) {
-    res.pop_back();
-    res.pop_back();
-  }
-  res += "] }";
+  write_vertex_json(vertex, res);
   return res;
 }
 
 std::string graph_to_json(const Graph& graph) {
   std::string res;
-  res = "{ \"depth\": ";
-  res += to_string(graph.get_depth());
-  res += ", \"vertices\": [ ";
-  for (const auto& vertex : graph.get_vertices()) {
-    res += vertex_to_json(vertex);
-    res += ", ";
-  }
-  if (graph.get_vertices().size()) {
-    res.pop_back();
-    res.pop_back();
-  }
-  res += " ], \"edges\": [ ";
-  for (const auto& edge : graph.get_edges()) {
-    res += edge_to_json(edge);
-    res += ", ";
-  }
-  if (graph.get_edges().size() > 0) {
-    res.pop_back();
-    res.pop_back();
-  }
-  res += " ] }\n";
+  write_graph_json(graph, res);
   return res;
 }
 
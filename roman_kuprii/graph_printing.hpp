@@ -1,18 +1,41 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
-namespace uni_cpp_practice {
+#include "graph.hpp"
 
-class Graph;
+namespace uni_cpp_practice {
 
 namespace graph_printing {
 
 std::string color_to_string(const Edge::Color& color);
 
 std::string graph_to_json(const Graph& graph);
-std::string vertex_to_json(const Vertex& graph);
-std::string edge_to_json(const Graph& graph);
+std::string vertex_to_json(const Vertex& vertex);
+std::string edge_to_json(const Edge& edge);
+
+// Append the JSON to `buffer` without temporary strings, so a buffer
+// reused between graphs stops reallocating once it fits the largest one.
+// The graph is sized with graph_json_size() first and rendered in place.
+void write_graph_json(const Graph& graph, std::string& buffer);
+void write_vertex_json(const Vertex& vertex, std::string& buffer);
+void write_edge_json(const Edge& edge, std::string& buffer);
+
+// Exact length of the write_graph_json() output, computed from the digit
+// counts of the numbers without rendering anything
+std::size_t graph_json_size(const Graph& graph);
+
+// Allocates the file at its final size and renders the JSON straight into
+// its mapping. Throws std::runtime_error on I/O errors.
+void write_graph_json_mapped(const Graph& graph, const std::string& filename);
+
+// Same bytes as write_graph_json(), rendered by `threads_count` threads,
+// each into its own buffer, and written with pwrite() at the offsets the
+// buffers take in the file. Throws std::runtime_error on I/O errors.
+void write_graph_json_file(const Graph& graph,
+                           const std::string& filename,
+                           int threads_count);
 
 }  // namespace graph_printing
 
@@ -0,0 +1,526 @@
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_reading.hpp"
+
+namespace {
+
+using uni_cpp_practice::Edge;
+using uni_cpp_practice::EdgeId;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::INVALID_ID;
+using uni_cpp_practice::VertexId;
+
+constexpr std::size_t CHUNK_SIZE = 1 << 20;
+constexpr std::size_t SIMD_BLOCK_SIZE = 16;
+
+[[noreturn]] void throw_parse_error(const std::string& message) {
+  throw std::runtime_error("Invalid graph JSON: " + message);
+}
+
+constexpr std::array<bool, 256> make_structural_table() {
+  std::array<bool, 256> table = {};
+  for (const char symbol : {'{', '}', '[', ']', ':', ',', '"'})
+    table[static_cast<unsigned char>(symbol)] = true;
+  return table;
+}
+
+constexpr auto STRUCTURAL_TABLE = make_structural_table();
+
+bool is_whitespace(char symbol) {
+  return symbol == ' ' || symbol == '\n' || symbol == '\t' || symbol == '\r';
+}
+
+// Appends positions of {}[]:," in `data` to `indexes`. Strings of the schema
+// hold no such characters, so this is the whole token structure: numbers are
+// the gaps between structural characters.
+void index_structurals(const char* data,
+                       std::size_t size,
+                       std::vector<std::uint32_t>& indexes) {
+  std::size_t position = 0;
+#ifdef __SSE2__
+  // Setting bit 0x20 turns '[' into '{' and ']' into '}'
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i open_brackets = _mm_set1_epi8('{');
+  const __m128i close_brackets = _mm_set1_epi8('}');
+  const __m128i colons = _mm_set1_epi8(':');
+  const __m128i commas = _mm_set1_epi8(',');
+  const __m128i quotes = _mm_set1_epi8('"');
+  for (; position + SIMD_BLOCK_SIZE <= size; position += SIMD_BLOCK_SIZE) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+    const __m128i folded = _mm_or_si128(block, case_bit);
+    const __m128i brackets =
+        _mm_or_si128(_mm_cmpeq_epi8(folded, open_brackets),
+                     _mm_cmpeq_epi8(folded, close_brackets));
+    const __m128i separators = _mm_or_si128(_mm_cmpeq_epi8(block, colons),
+                                            _mm_cmpeq_epi8(block, commas));
+    unsigned mask = _mm_movemask_epi8(_mm_or_si128(
+        _mm_or_si128(brackets, separators), _mm_cmpeq_epi8(block, quotes)));
+    while (mask != 0) {
+      indexes.push_back(position + __builtin_ctz(mask));
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; position < size; ++position)
+    if (STRUCTURAL_TABLE[static_cast<unsigned char>(data[position])])
+      indexes.push_back(position);
+}
+
+// Structural characters of the input one by one. The input is either
+// entirely in memory or read from a file in chunks; in the latter case
+// the unread tail starting at the last consumed character is carried over
+// to the next chunk, so a token is never split.
+class TokenStream {
+ public:
+  explicit TokenStream(std::string_view json)
+      : data_(json.data()), size_(json.size()), is_end_of_file_(true) {
+    if (size_ > UINT32_MAX)
+      throw_parse_error("too long, read it from a file instead");
+    indexes_.reserve(size_ / 4);
+    index_structurals(data_, size_, indexes_);
+  }
+
+  explicit TokenStream(int file_descriptor)
+      : file_descriptor_(file_descriptor) {
+    buffer_.resize(CHUNK_SIZE);
+    indexes_.reserve(CHUNK_SIZE / 4);
+    data_ = buffer_.data();
+  }
+
+  // Next structural character, '\0' at the end of input
+  char peek() {
+    if (!ensure(1))
+      return '\0';
+    return data_[indexes_[next_index_]];
+  }
+
+  char next() {
+    const char symbol = peek();
+    if (symbol != '\0')
+      ++next_index_;
+    return symbol;
+  }
+
+  bool try_consume(char symbol) {
+    if (peek() != symbol)
+      return false;
+    ++next_index_;
+    return true;
+  }
+
+  // Like try_consume(), but only if there's no number before the symbol,
+  // e.g. "[]" but not "[1]"
+  bool try_consume_after_nothing(char symbol) {
+    if (peek() != symbol)
+      return false;
+    const char* position =
+        next_index_ > 0 ? data_ + indexes_[next_index_ - 1] + 1 : data_;
+    const char* const end = data_ + indexes_[next_index_];
+    while (position != end && is_whitespace(*position))
+      ++position;
+    if (position != end)
+      return false;
+    ++next_index_;
+    return true;
+  }
+
+  void expect(char symbol) {
+    const char actual = next();
+    if (actual != symbol)
+      throw_parse_error(std::string("'") + symbol + "' expected, got " +
+                        (actual == '\0' ? "end of input"
+                                        : std::string("'") + actual + "'"));
+  }
+
+  // Valid until the next call
+  std::string_view next_string() {
+    expect('"');
+    if (!ensure(1) || data_[indexes_[next_index_]] != '"')
+      throw_parse_error("unterminated string");
+    const auto begin = indexes_[next_index_ - 1] + 1;
+    const auto end = indexes_[next_index_++];
+    return std::string_view(data_ + begin, end - begin);
+  }
+
+  // Number between the last consumed and the next structural character
+  int next_number() {
+    if (!ensure(1))
+      throw_parse_error("unexpected end of input");
+    const char* position = data_ + indexes_[next_index_ - 1] + 1;
+    const char* const end = data_ + indexes_[next_index_];
+    while (position != end && is_whitespace(*position))
+      ++position;
+    const bool is_negative = position != end && *position == '-';
+    if (is_negative)
+      ++position;
+    if (position == end || *position < '0' || *position > '9')
+      throw_parse_error("number expected");
+    long long number = 0;
+    for (; position != end && *position >= '0' && *position <= '9';
+         ++position) {
+      number = number * 10 + (*position - '0');
+      if (number > INT_MAX)
+        throw_parse_error("number is too big");
+    }
+    while (position != end && is_whitespace(*position))
+      ++position;
+    if (position != end)
+      throw_parse_error("unexpected character after a number");
+    return is_negative ? -number : number;
+  }
+
+  // Skips a value of a key the schema doesn't know
+  void skip_value() {
+    const char symbol = peek();
+    if (symbol == '"') {
+      next_string();
+      return;
+    }
+    if (symbol != '{' && symbol != '[')
+      return;  // A number or a literal, it has no structural characters
+    int nesting = 0;
+    do {
+      const char current = peek();
+      if (current == '"') {
+        next_string();
+        continue;
+      }
+      next();
+      if (current == '{' || current == '[')
+        ++nesting;
+      else if (current == '}' || current == ']')
+        --nesting;
+      else if (current == '\0')
+        throw_parse_error("unexpected end of input");
+    } while (nesting > 0);
+  }
+
+  void expect_end() {
+    if (peek() != '\0')
+      throw_parse_error("trailing characters");
+  }
+
+ private:
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::vector<std::uint32_t> indexes_;
+  std::size_t next_index_ = 0;
+
+  int file_descriptor_ = -1;
+  std::vector<char> buffer_;
+  bool is_end_of_file_ = false;
+
+  bool ensure(std::size_t count) {
+    while (next_index_ + count > indexes_.size()) {
+      if (is_end_of_file_)
+        return false;
+      read_chunk();
+    }
+    return true;
+  }
+
+  void read_chunk() {
+    // The last consumed character stays, a number may follow it
+    const std::size_t carry_from =
+        next_index_ > 0 ? indexes_[next_index_ - 1] : 0;
+    const std::size_t carried = size_ - carry_from;
+    std::memmove(buffer_.data(), buffer_.data() + carry_from, carried);
+    if (buffer_.size() < carried + CHUNK_SIZE)
+      buffer_.resize(carried + CHUNK_SIZE);
+    data_ = buffer_.data();
+
+    ssize_t read_size = 0;
+    do {
+      read_size = ::read(file_descriptor_, buffer_.data() + carried,
+                         CHUNK_SIZE);
+    } while (read_size == -1 && errno == EINTR);
+    if (read_size == -1)
+      throw std::runtime_error("Failed to read graph JSON");
+    is_end_of_file_ = read_size == 0;
+    size_ = carried + read_size;
+    if (size_ > UINT32_MAX)
+      throw_parse_error("token is too long");
+
+    indexes_.clear();
+    index_structurals(data_, size_, indexes_);
+    next_index_ = next_index_ > 0 ? 1 : 0;
+  }
+};
+
+struct EdgeRecord {
+  std::array<VertexId, 2> connected_vertices = {INVALID_ID, INVALID_ID};
+  Edge::Color color = Edge::Color::Gray;
+};
+
+// Edge ids a vertex lists, [begin, end) of GraphRecord::edge_ids
+struct EdgeIdsRecord {
+  VertexId vertex_id = INVALID_ID;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+};
+
+// Everything in the JSON, indexed by ids
+struct GraphRecord {
+  int depth = INVALID_ID;
+  std::vector<int> vertex_depths;
+  std::vector<bool> is_vertex_read;
+  std::vector<EdgeRecord> edges;
+  std::vector<bool> is_edge_read;
+  std::vector<EdgeId> edge_ids;
+  std::vector<EdgeIdsRecord> vertex_edge_ids;
+};
+
+template <typename T>
+void put_by_id(int id, const T& value, std::vector<T>& values) {
+  if (id < 0)
+    throw_parse_error("negative id");
+  if (static_cast<std::size_t>(id) >= values.size())
+    values.resize(id + 1);
+  values[id] = value;
+}
+
+void mark_read(int id, std::vector<bool>& is_read, const char* what) {
+  if (static_cast<std::size_t>(id) >= is_read.size())
+    is_read.resize(id + 1, false);
+  if (is_read[id])
+    throw_parse_error(std::string("duplicate ") + what + " id " +
+                      std::to_string(id));
+  is_read[id] = true;
+}
+
+Edge::Color color_from_string(std::string_view color) {
+  if (color == "gray" || color == "grey")
+    return Edge::Color::Gray;
+  if (color == "green")
+    return Edge::Color::Green;
+  if (color == "blue")
+    return Edge::Color::Blue;
+  if (color == "yellow")
+    return Edge::Color::Yellow;
+  if (color == "red")
+    return Edge::Color::Red;
+  throw_parse_error("unknown color " + std::string(color));
+}
+
+enum class Key { Depth, Vertices, Edges, Id, EdgeIds, VertexIds, Color, Other };
+
+Key key_from_string(std::string_view key) {
+  if (key == "id")
+    return Key::Id;
+  if (key == "edge_ids")
+    return Key::EdgeIds;
+  if (key == "vertex_ids")
+    return Key::VertexIds;
+  if (key == "color")
+    return Key::Color;
+  if (key == "depth")
+    return Key::Depth;
+  if (key == "vertices")
+    return Key::Vertices;
+  if (key == "edges")
+    return Key::Edges;
+  return Key::Other;
+}
+
+template <typename KeyCallback>
+void parse_object(TokenStream& tokens, const KeyCallback& parse_value) {
+  tokens.expect('{');
+  if (tokens.try_consume('}'))
+    return;
+  do {
+    // Converted right away, the next token may be in another chunk
+    const auto key = key_from_string(tokens.next_string());
+    tokens.expect(':');
+    parse_value(key);
+  } while (tokens.try_consume(','));
+  tokens.expect('}');
+}
+
+template <typename ElementCallback>
+void parse_array(TokenStream& tokens, const ElementCallback& parse_element) {
+  tokens.expect('[');
+  if (tokens.try_consume_after_nothing(']'))
+    return;
+  do {
+    parse_element();
+  } while (tokens.try_consume(','));
+  tokens.expect(']');
+}
+
+void parse_vertex(TokenStream& tokens, GraphRecord& record) {
+  VertexId vertex_id = INVALID_ID;
+  int depth = INVALID_ID;
+  const std::size_t edge_ids_begin = record.edge_ids.size();
+  parse_object(tokens, [&tokens, &record, &vertex_id, &depth](Key key) {
+    if (key == Key::Id)
+      vertex_id = tokens.next_number();
+    else if (key == Key::EdgeIds)
+      parse_array(tokens, [&tokens, &record]() {
+        record.edge_ids.push_back(tokens.next_number());
+      });
+    else if (key == Key::Depth)
+      depth = tokens.next_number();
+    else
+      tokens.skip_value();
+  });
+  if (vertex_id == INVALID_ID)
+    throw_parse_error("vertex without id");
+  mark_read(vertex_id, record.is_vertex_read, "vertex");
+  put_by_id(vertex_id, depth, record.vertex_depths);
+  record.vertex_edge_ids.push_back(
+      {vertex_id, edge_ids_begin, record.edge_ids.size()});
+}
+
+void parse_edge(TokenStream& tokens, GraphRecord& record) {
+  EdgeId edge_id = INVALID_ID;
+  EdgeRecord edge;
+  parse_object(tokens, [&tokens, &edge, &edge_id](Key key) {
+    if (key == Key::Id) {
+      edge_id = tokens.next_number();
+    } else if (key == Key::VertexIds) {
+      int index = 0;
+      parse_array(tokens, [&tokens, &edge, &index]() {
+        if (index == 2)
+          throw_parse_error("edge with more than two vertices");
+        edge.connected_vertices[index++] = tokens.next_number();
+      });
+    } else if (key == Key::Color) {
+      edge.color = color_from_string(tokens.next_string());
+    } else {
+      tokens.skip_value();
+    }
+  });
+  if (edge_id == INVALID_ID)
+    throw_parse_error("edge without id");
+  mark_read(edge_id, record.is_edge_read, "edge");
+  put_by_id(edge_id, edge, record.edges);
+}
+
+GraphRecord parse_graph(TokenStream& tokens) {
+  GraphRecord record;
+  parse_object(tokens, [&tokens, &record](Key key) {
+    if (key == Key::Depth)
+      record.depth = tokens.next_number();
+    else if (key == Key::Vertices)
+      parse_array(tokens,
+                  [&tokens, &record]() { parse_vertex(tokens, record); });
+    else if (key == Key::Edges)
+      parse_array(tokens,
+                  [&tokens, &record]() { parse_edge(tokens, record); });
+    else
+      tokens.skip_value();
+  });
+  tokens.expect_end();
+  return record;
+}
+
+// The gray edge that created a vertex is the first gray edge leading to it
+std::vector<int> restore_depths(const GraphRecord& record) {
+  const int vertices_num = record.vertex_depths.size();
+  std::vector<int> depths(vertices_num, INVALID_ID);
+  if (vertices_num > 0)
+    depths[0] = 0;
+  for (const auto& edge : record.edges) {
+    const auto [from_vertex_id, to_vertex_id] = edge.connected_vertices;
+    if (edge.color != Edge::Color::Gray || depths[to_vertex_id] != INVALID_ID)
+      continue;
+    if (depths[from_vertex_id] == INVALID_ID)
+      throw_parse_error("gray edge from a vertex without depth");
+    depths[to_vertex_id] = depths[from_vertex_id] + 1;
+  }
+  return depths;
+}
+
+Graph build_graph(const GraphRecord& record) {
+  const int vertices_num = record.vertex_depths.size();
+  if (!std::all_of(record.is_vertex_read.begin(), record.is_vertex_read.end(),
+                   [](bool is_read) { return is_read; }) ||
+      !std::all_of(record.is_edge_read.begin(), record.is_edge_read.end(),
+                   [](bool is_read) { return is_read; }))
+    throw_parse_error("ids have gaps");
+  for (const auto& edge : record.edges)
+    for (const auto& vertex_id : edge.connected_vertices)
+      if (vertex_id < 0 || vertex_id >= vertices_num)
+        throw_parse_error("edge to a nonexistent vertex");
+
+  const bool has_depths =
+      std::none_of(record.vertex_depths.begin(), record.vertex_depths.end(),
+                   [](int depth) { return depth == INVALID_ID; });
+  const auto depths =
+      has_depths ? record.vertex_depths : restore_depths(record);
+
+  Graph graph;
+  graph.reserve(vertices_num, record.edges.size());
+  for (const auto& depth : depths) {
+    if (depth == INVALID_ID)
+      throw_parse_error("vertex without gray edge to it");
+    if (depth < 0 || (graph.get_vertices_num() == 0 && depth != 0))
+      throw_parse_error("wrong vertex depth");
+    graph.restore_vertex(depth);
+  }
+  for (const auto& edge : record.edges)
+    graph.restore_edge(edge.connected_vertices[0], edge.connected_vertices[1],
+                       edge.color);
+
+  if (record.depth != INVALID_ID && graph.get_depth() != record.depth)
+    throw_parse_error("depth doesn't match the vertices");
+  for (const auto& edge_ids : record.vertex_edge_ids) {
+    const auto& restored = graph.get_vertices()[edge_ids.vertex_id];
+    if (!std::equal(restored.get_edges_ids().begin(),
+                    restored.get_edges_ids().end(),
+                    record.edge_ids.begin() + edge_ids.begin,
+                    record.edge_ids.begin() + edge_ids.end))
+      throw_parse_error("edge ids of vertex " +
+                        std::to_string(edge_ids.vertex_id) +
+                        " don't match the edges");
+  }
+  return graph;
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace graph_reading {
+
+Graph graph_from_json(std::string_view json) {
+  auto tokens = TokenStream(json);
+  return build_graph(parse_graph(tokens));
+}
+
+Graph read_graph_json(const std::string& filename) {
+  const int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (file_descriptor == -1)
+    throw std::runtime_error("Failed to open " + filename);
+  GraphRecord record;
+  try {
+    auto tokens = TokenStream(file_descriptor);
+    record = parse_graph(tokens);
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+  ::close(file_descriptor);
+  return build_graph(record);
+}
+
+}  // namespace graph_reading
+
+}  // namespace uni_cpp_practice
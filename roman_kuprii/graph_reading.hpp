@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "graph.hpp"
+
+namespace uni_cpp_practice {
+
+namespace graph_reading {
+
+// Loads graph JSON in the schema of graph_printing::graph_to_json() and of
+// the other printers in the course: keys in any order, optional top-level
+// and vertex "depth" ("gray" or "grey" edges), vertices and edges in any id
+// order. Without vertex depths they are recovered from the gray edges.
+// Throws std::runtime_error on malformed input.
+//
+// Only the structure is checked: the text between tokens is assumed to be
+// whitespace, except where a number is expected.
+Graph graph_from_json(std::string_view json);
+
+// Reads the file in fixed-size chunks, so memory use beyond the graph
+// doesn't depend on the file size
+Graph read_graph_json(const std::string& filename);
+
+}  // namespace graph_reading
+
+}  // namespace uni_cpp_practice
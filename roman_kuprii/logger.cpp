@@ -1,13 +1,38 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
 
 #include "logger.hpp"
 
+namespace {
+
+constexpr std::size_t MAX_BATCH_SIZE = 1 << 16;
+// Bounds the delay if a wake-up is missed
+constexpr auto SLEEP_TIMEOUT = std::chrono::milliseconds(50);
+
+}  // namespace
+
 namespace uni_cpp_practice {
 
+Logger::Logger() : slots_(std::make_unique<Slot[]>(CAPACITY)) {
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0,
+                "Capacity must be a power of two");
+  for (std::size_t position = 0; position < CAPACITY; ++position)
+    slots_[position].sequence.store(position, std::memory_order_relaxed);
+  thread_ = std::thread([this]() { run(); });
+}
+
 void Logger::set_output(const std::optional<std::string>& file_path) {
+  flush();
+  const std::lock_guard lock(sinks_mutex_);
   if (!file_path.has_value()) {
     if (file_stream_.has_value()) {
       file_stream_->close();
@@ -27,15 +52,144 @@ void Logger::set_output(const std::optional<std::string>& file_path) {
   }
 }
 
-void Logger::log(const std::string& text) {
-  std::cout << text << std::endl;
-  if (file_stream_.has_value())
-    file_stream_.value() << text << std::endl;
+void Logger::set_overflow_policy(const OverflowPolicy& overflow_policy) {
+  overflow_policy_.store(overflow_policy, std::memory_order_relaxed);
+}
+
+std::size_t Logger::get_dropped_count() const {
+  return dropped_count_.load(std::memory_order_relaxed);
+}
+
+void Logger::log(std::string text) {
+  while (!try_push(text)) {
+    if (overflow_policy_.load(std::memory_order_relaxed) ==
+        OverflowPolicy::Drop) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    wake_up();
+    std::this_thread::yield();
+  }
+  wake_up();
+}
+
+void Logger::flush() {
+  const auto position = enqueue_position_.load(std::memory_order_relaxed);
+  std::unique_lock lock(mutex_);
+  is_sleeping_.store(false);
+  message_logged_.notify_one();
+  batch_written_.wait(
+      lock, [this, position]() { return written_position_ >= position; });
 }
 
 Logger::~Logger() {
+  {
+    const std::lock_guard lock(mutex_);
+    should_stop_ = true;
+  }
+  message_logged_.notify_one();
+  thread_.join();
   if (file_stream_.has_value())
     file_stream_->close();
 }
 
+bool Logger::try_push(std::string& text) {
+  auto position = enqueue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    auto& slot = slots_[position & (CAPACITY - 1)];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<std::intptr_t>(sequence) -
+                            static_cast<std::intptr_t>(position);
+    if (difference < 0)
+      return false;
+    if (difference > 0) {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+      continue;
+    }
+    if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+      slot.text = std::move(text);
+      slot.sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+  }
+}
+
+bool Logger::try_pop(std::string& text) {
+  if (!has_pending())
+    return false;
+  auto& slot = slots_[dequeue_position_ & (CAPACITY - 1)];
+  text = std::move(slot.text);
+  slot.sequence.store(dequeue_position_ + CAPACITY, std::memory_order_release);
+  ++dequeue_position_;
+  return true;
+}
+
+bool Logger::has_pending() const {
+  const auto& slot = slots_[dequeue_position_ & (CAPACITY - 1)];
+  return slot.sequence.load(std::memory_order_acquire) ==
+         dequeue_position_ + 1;
+}
+
+void Logger::wake_up() {
+  // Pairs with the fence in run(): either the thread sees the new message
+  // before sleeping or this sees it sleeping
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!is_sleeping_.load(std::memory_order_relaxed))
+    return;
+  {
+    const std::lock_guard lock(mutex_);
+    is_sleeping_.store(false);
+  }
+  message_logged_.notify_one();
+}
+
+void Logger::run() {
+  std::string batch;
+  std::string text;
+  std::size_t reported_dropped_count = 0;
+  while (true) {
+    batch.clear();
+    while (batch.size() < MAX_BATCH_SIZE && try_pop(text)) {
+      batch += text;
+      batch += '\n';
+    }
+    const auto dropped_count = get_dropped_count();
+    if (dropped_count != reported_dropped_count) {
+      batch += "Logger: " +
+               std::to_string(dropped_count - reported_dropped_count) +
+               " messages dropped\n";
+      reported_dropped_count = dropped_count;
+    }
+
+    if (!batch.empty()) {
+      const std::lock_guard lock(sinks_mutex_);
+      std::cout.write(batch.data(), batch.size());
+      std::cout.flush();
+      if (file_stream_.has_value())
+        file_stream_->write(batch.data(), batch.size()).flush();
+    }
+
+    std::unique_lock lock(mutex_);
+    if (written_position_ != dequeue_position_) {
+      written_position_ = dequeue_position_;
+      batch_written_.notify_all();
+    }
+    if (!batch.empty())
+      continue;
+    if (should_stop_)
+      return;
+    is_sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_pending()) {
+      is_sleeping_.store(false, std::memory_order_relaxed);
+      continue;
+    }
+    message_logged_.wait_for(lock, SLEEP_TIMEOUT, [this]() {
+      return !is_sleeping_.load(std::memory_order_relaxed) || should_stop_;
+    });
+    is_sleeping_.store(false, std::memory_order_relaxed);
+  }
+}
+
 }  // namespace uni_cpp_practice
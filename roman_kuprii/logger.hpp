@@ -1,31 +1,106 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <fstream>
-#include <iostream>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+
+// Messages below this level are compiled out: -DLOG_LEVEL=Info (make
+// LOG_LEVEL=Info) for production builds, everything is kept by default
+#ifndef LOG_LEVEL
+#define LOG_LEVEL Debug
+#endif
 
 namespace uni_cpp_practice {
 
 class Graph;
 
+enum class LogLevel { Debug, Info, Warning, Error };
+
+constexpr LogLevel COMPILED_LOG_LEVEL = LogLevel::LOG_LEVEL;
+
+constexpr bool is_log_level_enabled(LogLevel level) {
+  return level >= COMPILED_LOG_LEVEL;
+}
+
+// Messages are put into a bounded lock-free ring by any thread and written
+// to the console and the file in batches by a background thread, so log()
+// only moves the string into a slot.
 class Logger {
  public:
+  // What log() does when the ring is full
+  enum class OverflowPolicy { Block, Drop };
+
   static Logger& get_logger() {
     static Logger logger;
     return logger;
   }
 
-  void log(const std::string& text);
+  void log(std::string text);
+
+  // The message is only made if the level is compiled in:
+  //   logger.log<LogLevel::Debug>([&]() { return describe(graph); });
+  template <LogLevel level, typename MakeMessage>
+  void log(const MakeMessage& make_message) {
+    if constexpr (is_log_level_enabled(level))
+      log(std::string(make_message()));
+  }
+
+  // Waits until everything logged before is written
+  void flush();
 
   void set_output(const std::optional<std::string>& file_path);
 
+  void set_overflow_policy(const OverflowPolicy& overflow_policy);
+
+  // Messages lost because of OverflowPolicy::Drop
+  std::size_t get_dropped_count() const;
+
   ~Logger();
 
  private:
+  static constexpr std::size_t CAPACITY = 1 << 12;
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  // The sequence tells whose turn it is: the producer of position `pos` waits
+  // for `pos`, the consumer for `pos + 1`
+  struct alignas(CACHE_LINE_SIZE) Slot {
+    std::atomic<std::size_t> sequence;
+    std::string text;
+  };
+
+  const std::unique_ptr<Slot[]> slots_;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position_ = 0;
+  // Only touched by the thread
+  alignas(CACHE_LINE_SIZE) std::size_t dequeue_position_ = 0;
+  std::atomic<std::size_t> dropped_count_ = 0;
+  std::atomic<OverflowPolicy> overflow_policy_ = OverflowPolicy::Block;
+  std::atomic<bool> is_sleeping_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable message_logged_;
+  std::condition_variable batch_written_;
+  bool should_stop_ = false;
+  std::size_t written_position_ = 0;
+
+  // Written by the thread under sinks_mutex_
+  std::mutex sinks_mutex_;
   std::optional<std::ofstream> file_stream_ = std::nullopt;
 
-  Logger() = default;
+  std::thread thread_;
+
+  Logger();
+  bool try_push(std::string& text);
+  bool try_pop(std::string& text);
+  bool has_pending() const;
+  void wake_up();
+  void run();
+
   Logger(const Logger& root) = delete;
   Logger& operator=(const Logger&) = delete;
   Logger(Logger&&) = delete;
@@ -33,3 +108,17 @@ class Logger {
 };
 
 }  // namespace uni_cpp_practice
+
+// Logs `message` with the level's name (Debug, Info, ...). When the level
+// is compiled out neither the message nor the logger call are evaluated.
+#define LOG_AT(level, message)                                              \
+  do {                                                                      \
+    if constexpr (::uni_cpp_practice::is_log_level_enabled(                 \
+                      ::uni_cpp_practice::LogLevel::level))                 \
+      ::uni_cpp_practice::Logger::get_logger().log(message);                \
+  } while (false)
+
+#define LOG_DEBUG(message) LOG_AT(Debug, message)
+#define LOG_INFO(message) LOG_AT(Info, message)
+#define LOG_WARNING(message) LOG_AT(Warning, message)
+#define LOG_ERROR(message) LOG_AT(Error, message)
@@ -1,55 +1,37 @@
 #include <array>
-#include <chrono>
-#include <fstream>
-#include <iomanip>
 #include <iostream>
 #include <memory>
-#include <sstream>
 #include <string>
 #include <vector>
 
+#include "date_time.hpp"
 #include "graph.hpp"
 #include "graph_printing.hpp"
 #include "logger.hpp"
+#include "perf_counters.hpp"
 
 namespace {
 
-const std::string JSON_GRAPH_FILENAME = "temp/graph_";
-
 using std::to_string;
 
-std::string get_datetime() {
-  const auto date_time = std::chrono::system_clock::now();
-  const auto date_time_t = std::chrono::system_clock::to_time_t(date_time);
-  std::stringstream date_time_string;
-  date_time_string << std::put_time(std::localtime(&date_time_t),
-                                    "%Y.%m.%d %H:%M:%S");
-  return date_time_string.str();
-}
-
 }  // namespace
 
 namespace uni_cpp_practice {
 
 namespace logging_helping {
 
-void write_graph(const Graph& graph, int graph_num) {
-  std::ofstream out;
-  const std::string filename =
-      JSON_GRAPH_FILENAME + std::to_string(graph_num) + ".json";
-  out.open(filename, std::ofstream::out | std::ofstream::trunc);
-  out << graph_printing::graph_to_json(graph);
-  out.close();
-}
-
 std::string write_log_start(int graph_num) {
-  std::string res = get_datetime();
+  std::string res(date_time::get_datetime());
   res += ": Graph " + to_string(graph_num) + ", Generation Started";
   return res;
 }
 
-std::string write_log_end(Graph& work_graph, int graph_num) {
-  std::string res = get_datetime();
+// The counters of the phases are added when any of them were counted
+std::string write_log_end(
+    const Graph& work_graph,
+    int graph_num,
+    const std::array<perf_counters::Counts, 5>& phase_counts = {}) {
+  std::string res(date_time::get_datetime());
   res += ": Graph " + to_string(graph_num) + ", Generation Ended {\n";
   res += "  depth: " + to_string(work_graph.get_depth()) + ",\n";
   res += "  vertices: " + to_string(work_graph.get_vertices_num()) + ", [";
@@ -77,6 +59,32 @@ std::string write_log_end(Graph& work_graph, int graph_num) {
            to_string(work_graph.get_edge_ids_with_color(color).size()) + ", ";
   }
   res.pop_back();
+  res.pop_back();
+  res += "},\n";
+
+  const auto memory_usage = work_graph.memory_usage();
+  res += "  memory: " + to_string(memory_usage.total()) + " bytes, {";
+  res += "vertices: " + to_string(memory_usage.vertices) + ", ";
+  res += "edges: " + to_string(memory_usage.edges) + ", ";
+  res += "adjacency: " + to_string(memory_usage.adjacency) + ", ";
+  res += "depth_index: " + to_string(memory_usage.depth_index) + ", ";
+  res += "color_index: " + to_string(memory_usage.color_index) + "}";
+
+  bool has_phase_counts = false;
+  for (const auto& counts : phase_counts)
+    has_phase_counts = has_phase_counts || perf_counters::has_counts(counts);
+  if (has_phase_counts) {
+    res += ",\n  counters: {\n";
+    perf_counters::Counts total_counts;
+    for (const auto& color : colors) {
+      const auto& counts = phase_counts[static_cast<int>(color)];
+      perf_counters::add_counts(total_counts, counts);
+      res += "    " + graph_printing::color_to_string(color) + ": {" +
+             perf_counters::counts_to_string(counts) + "},\n";
+    }
+    res += "    total: {" + perf_counters::counts_to_string(total_counts) +
+           "}\n  }";
+  }
   res += "\n}\n";
   return res;
 }
@@ -1,27 +1,46 @@
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <random>
 #include <string>
 
+#include "allocation_profiler.hpp"
+#include "chrome_trace.hpp"
+#include "event_trace.hpp"
 #include "graph.hpp"
+#include "graph_archive.hpp"
 #include "graph_generation_controller.hpp"
 #include "graph_generator.hpp"
 #include "graph_printing.hpp"
 #include "logger.hpp"
 #include "logging_helping.hpp"
+#include "perf_counters.hpp"
+
+#ifndef PERF_COUNTERS
+#define PERF_COUNTERS 0
+#endif
 
 constexpr int GRAPHS_NUMBER = 0;
 constexpr int INVALID_NEW_DEPTH = -1;
 constexpr int INVALID_NEW_VERTICES_NUMBER = -1;
 constexpr int INVALID_THREADS_NUMBER = 0;
+constexpr long long NO_MEMORY_BUDGET = 0;
 const std::string LOG_FILENAME = "temp/log.txt";
+const std::string ARCHIVE_FILENAME = "temp/graphs.archive";
+const std::string TRACE_FILENAME = "temp/events.trace";
 const std::string DIRECTORY_NAME = "temp";
 
 const int MAX_THREADS_COUNT = std::thread::hardware_concurrency();
 
-using uni_cpp_practice::Graph;
 using uni_cpp_practice::GraphGenerator;
 using uni_cpp_practice::Logger;
+using uni_cpp_practice::allocation_profiler::Phase;
+using uni_cpp_practice::chrome_trace::Tracer;
+using uni_cpp_practice::event_trace::TraceWriter;
+using uni_cpp_practice::graph_archive::ArchiveWriter;
 using uni_cpp_practice::graph_generation_controller::GraphGenerationController;
 
 int handle_graphs_number_input() {
@@ -62,11 +81,25 @@ int handle_threads_number_input() {
   return threads_count;
 }
 
+// Bytes for the graphs generated at the same time, fewer threads are used
+// when the estimated graph size doesn't fit a graph per thread
+std::optional<std::size_t> handle_memory_budget_input() {
+  long long memory_budget = NO_MEMORY_BUDGET;
+  do {
+    std::cout << "Enter memory budget in bytes, zero for none" << std::endl;
+    std::cin >> memory_budget;
+  } while (memory_budget < NO_MEMORY_BUDGET);
+  if (memory_budget == NO_MEMORY_BUDGET)
+    return std::nullopt;
+  return memory_budget;
+}
+
 void prepare_temp_directory() {
   std::filesystem::create_directory(DIRECTORY_NAME);
 }
 
-int main() {
+// `prog <file>` also writes a Chrome trace of the threads to the file
+int main(int argc, char** argv) {
   auto& logger = Logger::get_logger();
   prepare_temp_directory();
   logger.set_output(LOG_FILENAME);
@@ -75,23 +108,75 @@ int main() {
   const int depth = handle_depth_input();
   const int new_vertices_num = handle_vertices_number_input();
   const int threads_count = handle_threads_number_input();
-  const auto params = GraphGenerator::Params(depth, new_vertices_num);
-
-  auto generation_controller =
-      GraphGenerationController(threads_count, graphs_count, params);
-  auto graphs = std::vector<Graph>();
+  const auto memory_budget = handle_memory_budget_input();
+  // Every run is seeded, the archive keeps the seed of every graph's gray
+  // tree structure, see GraphGenerator::get_graph_seed()
+  const std::uint64_t seed = std::random_device()();
+  const auto params = GraphGenerator::Params(depth, new_vertices_num, seed);
+  LOG_INFO("Seed: " + std::to_string(seed));
 
-  graphs.reserve(graphs_count);
+  auto generation_controller = GraphGenerationController(
+      threads_count, graphs_count, params, memory_budget);
+  // The budget is divided by the ~99th percentile of the graph size
+  const auto size_estimate = GraphGenerator::estimate_size(params);
+  LOG_INFO("Estimated graph size: " +
+           std::to_string(size_estimate.bytes_quantile) + " bytes, threads: " +
+           std::to_string(generation_controller.get_threads_count()) + " of " +
+           std::to_string(threads_count));
+  auto archive = ArchiveWriter(ARCHIVE_FILENAME);
+  auto trace = TraceWriter(TRACE_FILENAME);
 
+  // Hardware counters of the phases in the log, see the Makefile
+  uni_cpp_practice::perf_counters::set_enabled(PERF_COUNTERS);
+  auto& tracer = Tracer::get_tracer();
+  if (argc > 1)
+    tracer.start();
   generation_controller.generate(
-      [&logger](int index) {
-        logger.log(uni_cpp_practice::logging_helping::write_log_start(index));
+      [&trace](int index) {
+        const auto allocation_scope =
+            uni_cpp_practice::allocation_profiler::Scope(Phase::Logging);
+        trace.record(uni_cpp_practice::event_trace::make_started_event(index));
+        // The trace has these events in every build
+        LOG_DEBUG(uni_cpp_practice::logging_helping::write_log_start(index));
       },
-      [&logger, &graphs](uni_cpp_practice::Graph graph, int index) {
-        logger.log(
-            uni_cpp_practice::logging_helping::write_log_end(graph, index));
-        graphs.push_back(graph);
-        uni_cpp_practice::logging_helping::write_graph(graph, index);
+      [&trace, &archive, &params, &generation_controller](
+          const uni_cpp_practice::Graph& graph, int index) {
+        {
+          const auto allocation_scope =
+              uni_cpp_practice::allocation_profiler::Scope(Phase::Logging);
+          trace.record(
+              uni_cpp_practice::event_trace::make_finished_event(graph, index));
+          // The job has stored the stats of its graph before the callback
+          LOG_DEBUG(uni_cpp_practice::logging_helping::write_log_end(
+              graph, index,
+              generation_controller.get_generation_stats()[index]
+                  .phase_counts));
+        }
+        archive.append(index, params,
+                       GraphGenerator::get_graph_seed(params, index).value(),
+                       graph);
       });
+  if (argc > 1) {
+    tracer.stop();
+    tracer.write(argv[1]);
+  }
+  archive.close();
+  trace.close();
+  LOG_INFO("Output writer stalls: " +
+           std::to_string(archive.get_output_writer().get_stalls_count()));
+  LOG_INFO("Peak memory of graphs in generation: " +
+           std::to_string(generation_controller.get_peak_memory_usage()) +
+           " bytes");
+  LOG_INFO("Memory kept by the graph pool: " +
+           std::to_string(generation_controller.get_pool_memory_usage()) +
+           " bytes");
+  LOG_INFO(uni_cpp_practice::graph_generation_controller::
+               format_generation_stats(
+                   generation_controller.get_generation_stats()));
+  // Built with ALLOCATION_PROFILER=1, see the Makefile
+  if (uni_cpp_practice::allocation_profiler::is_enabled())
+    LOG_INFO(uni_cpp_practice::graph_generation_controller::
+                 format_graph_allocations(
+                     generation_controller.get_graph_allocations()));
   return 0;
 }
@@ -0,0 +1,157 @@
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "output_writer.hpp"
+
+namespace {
+
+// Returns false on error
+bool write_all(int file_descriptor, std::string_view data) {
+  while (!data.empty()) {
+    const auto written = ::write(file_descriptor, data.data(), data.size());
+    if (written == -1) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data.remove_prefix(written);
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+OutputWriter::OutputWriter(int file_descriptor,
+                           const std::string& filename,
+                           const Options& options)
+    : file_descriptor_(file_descriptor),
+      filename_(filename),
+      options_(options) {
+  assert(options.buffers_count >= 2);
+  filling_buffer_.reserve(options.buffer_size);
+  free_buffers_.resize(options.buffers_count - 1);
+  for (auto& buffer : free_buffers_)
+    buffer.reserve(options.buffer_size);
+  thread_ = std::thread([this]() { run(); });
+}
+
+OutputWriter::~OutputWriter() {
+  if (!thread_.joinable())
+    return;
+  try {
+    close();
+  } catch (const std::runtime_error&) {
+  }
+}
+
+void OutputWriter::submit(std::string_view data) {
+  std::unique_lock lock(mutex_);
+  assert(!should_stop_ && "Writer is closed");
+  throw_if_failed();
+  filling_buffer_.append(data);
+  if (filling_buffer_.size() < options_.buffer_size)
+    return;
+  wait_for_free_buffer(lock);
+  // Another thread could have queued it while this one was waiting
+  if (filling_buffer_.size() >= options_.buffer_size)
+    queue_filling_buffer();
+}
+
+void OutputWriter::flush() {
+  std::unique_lock lock(mutex_);
+  if (!filling_buffer_.empty()) {
+    wait_for_free_buffer(lock);
+    if (!filling_buffer_.empty())
+      queue_filling_buffer();
+  }
+  buffer_written_.wait(
+      lock, [this]() { return queued_buffers_.empty() && !is_writing_; });
+  throw_if_failed();
+}
+
+void OutputWriter::close() {
+  if (!thread_.joinable())
+    return;
+  try {
+    flush();
+  } catch (const std::runtime_error&) {
+    // The thread has to be stopped anyway, the error is thrown below
+  }
+  {
+    const std::lock_guard lock(mutex_);
+    should_stop_ = true;
+  }
+  buffer_queued_.notify_one();
+  thread_.join();
+
+  throw_if_failed();
+  if (options_.fsync_policy != FsyncPolicy::Never &&
+      ::fsync(file_descriptor_) == -1)
+    throw std::runtime_error("Failed to sync " + filename_);
+}
+
+int OutputWriter::get_stalls_count() const {
+  const std::lock_guard lock(mutex_);
+  return stalls_count_;
+}
+
+void OutputWriter::run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    buffer_queued_.wait(
+        lock, [this]() { return !queued_buffers_.empty() || should_stop_; });
+    if (queued_buffers_.empty())
+      return;
+    auto buffer = std::move(queued_buffers_.front());
+    queued_buffers_.pop_front();
+    is_writing_ = true;
+    // After an error buffers are only recycled, so submit() can't get stuck
+    const bool should_write = error_.empty();
+    lock.unlock();
+
+    std::string error;
+    if (should_write) {
+      if (!write_all(file_descriptor_, buffer))
+        error = "Failed to write " + filename_;
+      else if (options_.fsync_policy == FsyncPolicy::EveryBuffer &&
+               ::fdatasync(file_descriptor_) == -1)
+        error = "Failed to sync " + filename_;
+    }
+    buffer.clear();
+
+    lock.lock();
+    if (error_.empty())
+      error_ = std::move(error);
+    free_buffers_.push_back(std::move(buffer));
+    is_writing_ = false;
+    buffer_written_.notify_all();
+  }
+}
+
+void OutputWriter::wait_for_free_buffer(std::unique_lock<std::mutex>& lock) {
+  if (!free_buffers_.empty())
+    return;
+  ++stalls_count_;
+  buffer_written_.wait(lock, [this]() { return !free_buffers_.empty(); });
+}
+
+void OutputWriter::queue_filling_buffer() {
+  queued_buffers_.push_back(std::move(filling_buffer_));
+  filling_buffer_ = std::move(free_buffers_.back());
+  free_buffers_.pop_back();
+  buffer_queued_.notify_one();
+}
+
+void OutputWriter::throw_if_failed() const {
+  if (!error_.empty())
+    throw std::runtime_error(error_);
+}
+
+}  // namespace uni_cpp_practice
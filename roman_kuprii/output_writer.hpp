@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace uni_cpp_practice {
+
+// Writes to a file on its own thread. Data submitted from any thread is
+// gathered into a buffer, full buffers are queued to the writer thread and
+// recycled once written, so submitting only waits for the disk when every
+// buffer of the budget is queued.
+class OutputWriter {
+ public:
+  enum class FsyncPolicy { Never, OnClose, EveryBuffer };
+
+  struct Options {
+    std::size_t buffer_size = 1 << 20;
+    // 2 for double buffering, 3 for triple buffering and so on
+    int buffers_count = 3;
+    FsyncPolicy fsync_policy = FsyncPolicy::OnClose;
+  };
+
+  // Writes from the current position of `file_descriptor`, which stays
+  // owned by the caller; `filename` is for error messages
+  OutputWriter(int file_descriptor,
+               const std::string& filename,
+               const Options& options);
+  // Closes the writer if close() wasn't called, errors are lost then
+  ~OutputWriter();
+
+  // Write errors of earlier buffers are thrown from the following calls as
+  // std::runtime_error
+  void submit(std::string_view data);
+
+  // Waits until everything submitted is written
+  void flush();
+
+  // Flushes, syncs the file if the policy says so and stops the thread
+  void close();
+
+  // Times submit() had to wait for a buffer to be written
+  int get_stalls_count() const;
+
+ private:
+  const int file_descriptor_;
+  const std::string filename_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable buffer_queued_;
+  std::condition_variable buffer_written_;
+  std::string filling_buffer_;
+  std::deque<std::string> queued_buffers_;
+  std::vector<std::string> free_buffers_;
+  bool is_writing_ = false;
+  bool should_stop_ = false;
+  std::string error_;
+  int stalls_count_ = 0;
+  std::thread thread_;
+
+  void run();
+  void wait_for_free_buffer(std::unique_lock<std::mutex>& lock);
+  // Needs the lock and a free buffer
+  void queue_filling_buffer();
+  void throw_if_failed() const;
+
+  OutputWriter(const OutputWriter&) = delete;
+  OutputWriter& operator=(const OutputWriter&) = delete;
+  OutputWriter(OutputWriter&&) = delete;
+  OutputWriter& operator=(OutputWriter&&) = delete;
+};
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,144 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "perf_counters.hpp"
+
+namespace {
+
+using uni_cpp_practice::perf_counters::COUNTERS_COUNT;
+
+constexpr int INVALID_FILE_DESCRIPTOR = -1;
+
+std::atomic<bool> is_counting_enabled = false;
+
+#ifdef __linux__
+
+// PERF_COUNT_HW_CACHE_MISSES is the last level cache on most CPUs
+constexpr std::array<std::uint64_t, COUNTERS_COUNT> EVENT_CONFIGS = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+int open_counter(std::uint64_t config) {
+  perf_event_attr attributes = {};
+  attributes.size = sizeof(attributes);
+  attributes.type = PERF_TYPE_HARDWARE;
+  attributes.config = config;
+  attributes.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attributes.inherit = 1;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  // The calling thread on any CPU, no group, so that inherit is allowed
+  return syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+std::optional<std::uint64_t> read_counter(int file_descriptor) {
+  // value, time enabled, time running
+  std::array<std::uint64_t, 3> values = {};
+  if (read(file_descriptor, values.data(), sizeof(values)) !=
+          static_cast<ssize_t>(sizeof(values)) ||
+      values[2] == 0)
+    return std::nullopt;
+  if (values[2] == values[1])
+    return values[0];
+  return static_cast<std::uint64_t>(static_cast<double>(values[0]) *
+                                    values[1] / values[2]);
+}
+
+#endif
+
+}  // namespace
+
+namespace uni_cpp_practice {
+
+namespace perf_counters {
+
+void set_enabled(bool is_enabled) {
+  is_counting_enabled.store(is_enabled, std::memory_order_relaxed);
+}
+
+bool is_enabled() {
+  return is_counting_enabled.load(std::memory_order_relaxed);
+}
+
+ThreadCounters::ThreadCounters() {
+  file_descriptors_.fill(INVALID_FILE_DESCRIPTOR);
+#ifdef __linux__
+  if (!is_enabled())
+    return;
+  for (int counter = 0; counter < COUNTERS_COUNT; ++counter)
+    file_descriptors_[counter] = open_counter(EVENT_CONFIGS[counter]);
+#endif
+}
+
+ThreadCounters::~ThreadCounters() {
+#ifdef __linux__
+  for (const int file_descriptor : file_descriptors_)
+    if (file_descriptor != INVALID_FILE_DESCRIPTOR)
+      close(file_descriptor);
+#endif
+}
+
+Counts ThreadCounters::read() const {
+  Counts counts;
+#ifdef __linux__
+  for (int counter = 0; counter < COUNTERS_COUNT; ++counter)
+    if (file_descriptors_[counter] != INVALID_FILE_DESCRIPTOR)
+      counts[counter] = read_counter(file_descriptors_[counter]);
+#endif
+  return counts;
+}
+
+void add_counts(Counts& counts, const Counts& other) {
+  for (int counter = 0; counter < COUNTERS_COUNT; ++counter)
+    if (other[counter].has_value())
+      counts[counter] = counts[counter].value_or(0) + other[counter].value();
+}
+
+bool has_counts(const Counts& counts) {
+  for (const auto& count : counts)
+    if (count.has_value())
+      return true;
+  return false;
+}
+
+const char* counter_to_string(Counter counter) {
+  switch (counter) {
+    case Counter::Cycles:
+      return "cycles";
+    case Counter::Instructions:
+      return "instructions";
+    case Counter::LlcMisses:
+      return "llc_misses";
+    case Counter::BranchMisses:
+      return "branch_misses";
+  }
+  return "";
+}
+
+std::string counts_to_string(const Counts& counts) {
+  std::string result;
+  for (int counter = 0; counter < COUNTERS_COUNT; ++counter) {
+    if (counter > 0)
+      result += ", ";
+    result += counter_to_string(static_cast<Counter>(counter));
+    result += ": ";
+    result += counts[counter].has_value()
+                  ? std::to_string(counts[counter].value())
+                  : "-";
+  }
+  return result;
+}
+
+}  // namespace perf_counters
+
+}  // namespace uni_cpp_practice
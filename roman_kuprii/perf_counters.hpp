@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace uni_cpp_practice {
+
+namespace perf_counters {
+
+// Hardware counters of Linux perf_event_open, user space only
+enum class Counter { Cycles, Instructions, LlcMisses, BranchMisses };
+
+constexpr int COUNTERS_COUNT = 4;
+
+// Indexed by Counter, empty for a counter the machine doesn't provide
+using Counts = std::array<std::optional<std::uint64_t>, COUNTERS_COUNT>;
+
+// Counting is off until enabled, opening the counters costs a few syscalls
+// per phase
+void set_enabled(bool is_enabled);
+bool is_enabled();
+
+// Counts the calling thread and the threads it starts from construction on,
+// a started thread is added when it exits. Every counter is empty when
+// counting is off, outside Linux, in VMs without a PMU or when
+// perf_event_paranoid forbids it.
+class ThreadCounters {
+ public:
+  ThreadCounters();
+  ~ThreadCounters();
+
+  // Since construction, scaled up if the kernel multiplexed the counters
+  Counts read() const;
+
+ private:
+  std::array<int, COUNTERS_COUNT> file_descriptors_;
+
+  ThreadCounters(const ThreadCounters&) = delete;
+  ThreadCounters& operator=(const ThreadCounters&) = delete;
+  ThreadCounters(ThreadCounters&&) = delete;
+  ThreadCounters& operator=(ThreadCounters&&) = delete;
+};
+
+// Empty counters add as zero, the sum is empty only if both are
+void add_counts(Counts& counts, const Counts& other);
+
+bool has_counts(const Counts& counts);
+
+const char* counter_to_string(Counter counter);
+
+// "cycles: 1200, instructions: 2400, llc_misses: -, branch_misses: 12"
+std::string counts_to_string(const Counts& counts);
+
+}  // namespace perf_counters
+
+}  // namespace uni_cpp_practice
@@ -0,0 +1,59 @@
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../graph_archive.hpp"
+
+namespace {
+
+using uni_cpp_practice::graph_archive::ArchiveReader;
+
+void list_graphs(const ArchiveReader& archive) {
+  for (const auto& record : archive) {
+    const auto& entry = record.entry;
+    std::cout << "graph " << entry.graph_id << ": depth " << entry.depth
+              << ", new_vertices_num " << entry.new_vertices_num
+              << ", gray tree seed " << entry.gray_tree_seed << ", "
+              << entry.length << " bytes" << std::endl;
+  }
+}
+
+void extract_graph(const ArchiveReader& archive,
+                   int graph_id,
+                   const std::string& json_filename) {
+  const auto* entry = archive.find(graph_id);
+  if (entry == nullptr)
+    throw std::runtime_error("No graph " + std::to_string(graph_id) +
+                             " in the archive");
+  const auto json = archive.get_json(*entry);
+  std::ofstream out(json_filename, std::ofstream::trunc);
+  if (!out.is_open())
+    throw std::runtime_error("Failed to open " + json_filename);
+  out.write(json.data(), json.size());
+  out.close();
+  if (out.fail())
+    throw std::runtime_error("Failed to write " + json_filename);
+}
+
+}  // namespace
+
+// Lists the graphs of an archive, or extracts one of them as JSON
+int main(int argc, char** argv) {
+  if (argc != 2 && argc != 4) {
+    std::cerr << "Usage: " << argv[0] << " <archive> [<graph_id> <output>]"
+              << std::endl;
+    return 1;
+  }
+  try {
+    const ArchiveReader archive(argv[1]);
+    if (argc == 2)
+      list_graphs(archive);
+    else
+      extract_graph(archive, std::stoi(argv[2]), argv[3]);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
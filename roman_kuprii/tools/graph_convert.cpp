@@ -0,0 +1,56 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../graph_binary.hpp"
+#include "../graph_compression.hpp"
+#include "../graph_printing.hpp"
+#include "../graph_reading.hpp"
+
+namespace {
+
+const std::string JSON_EXTENSION = ".json";
+const std::string COMPRESSED_EXTENSION = ".rkgz";
+
+namespace graph_compression = uni_cpp_practice::graph_compression;
+
+bool has_extension(const std::string& filename, const std::string& extension) {
+  return filename.size() >= extension.size() &&
+         filename.compare(filename.size() - extension.size(),
+                          extension.size(), extension) == 0;
+}
+
+void write_json(const uni_cpp_practice::Graph& graph,
+                const std::string& json_filename) {
+  uni_cpp_practice::graph_printing::write_graph_json_mapped(graph,
+                                                            json_filename);
+}
+
+}  // namespace
+
+// Converts a graph between JSON and the binary or the compressed (.rkgz)
+// format, the direction is chosen by the file extensions
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <input> <output>" << std::endl;
+    return 1;
+  }
+  const std::string input = argv[1];
+  const std::string output = argv[2];
+  try {
+    if (has_extension(input, JSON_EXTENSION) &&
+        has_extension(output, COMPRESSED_EXTENSION))
+      graph_compression::write_graph_compressed(
+          uni_cpp_practice::graph_reading::read_graph_json(input), output);
+    else if (has_extension(input, COMPRESSED_EXTENSION))
+      write_json(graph_compression::read_graph_compressed(input), output);
+    else if (has_extension(input, JSON_EXTENSION))
+      uni_cpp_practice::graph_binary::json_to_binary(input, output);
+    else
+      uni_cpp_practice::graph_binary::binary_to_json(input, output);
+  } catch (const std::runtime_error& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../event_trace.hpp"
+#include "../graph.hpp"
+#include "../graph_printing.hpp"
+
+namespace {
+
+namespace event_trace = uni_cpp_practice::event_trace;
+using event_trace::Event;
+using event_trace::EventType;
+using uni_cpp_practice::Edge;
+
+constexpr auto DATETIME_FORMAT = "%Y.%m.%d %H:%M:%S";
+// CSV column names, color_to_string() quotes them
+constexpr std::array<const char*, event_trace::COLORS_COUNT> COLOR_NAMES = {
+    "gray", "green", "blue", "yellow", "red"};
+
+std::string format_datetime(std::uint64_t timestamp_ns) {
+  const std::time_t time = timestamp_ns / 1000000000;
+  std::tm local_time;
+  localtime_r(&time, &local_time);
+  char buffer[64];
+  return std::string(buffer, std::strftime(buffer, sizeof(buffer),
+                                           DATETIME_FORMAT, &local_time));
+}
+
+// Same lines as logging_helping, without the per-depth vertex counts and
+// memory usage the events don't keep
+void print_text(const Event& event) {
+  std::cout << format_datetime(event.timestamp_ns) << ": Graph "
+            << event.graph_index;
+  if (event.type == EventType::GenerationStarted) {
+    std::cout << ", Generation Started" << std::endl;
+    return;
+  }
+  std::cout << ", Generation Ended {\n";
+  std::cout << "  depth: " << event.depth << ",\n";
+  std::cout << "  vertices: " << event.vertices_num << ",\n";
+  std::cout << "  edges: " << event.edges_num << ", {";
+  for (int color = 0; color < event_trace::COLORS_COUNT; ++color) {
+    if (color != 0)
+      std::cout << ", ";
+    std::cout << uni_cpp_practice::graph_printing::color_to_string(
+                     static_cast<Edge::Color>(color))
+              << ": " << event.colors_counts[color];
+  }
+  std::cout << "},\n";
+  std::cout << "  thread: " << event.thread_id << "\n}\n" << std::endl;
+}
+
+void print_csv_header() {
+  std::cout << "timestamp_ns,thread_id,graph_index,event,depth,vertices,edges";
+  for (const auto* color_name : COLOR_NAMES)
+    std::cout << ',' << color_name;
+  std::cout << '\n';
+}
+
+void print_csv(const Event& event) {
+  std::cout << event.timestamp_ns << ',' << event.thread_id << ','
+            << event.graph_index << ','
+            << (event.type == EventType::GenerationStarted ? "started"
+                                                           : "finished")
+            << ',' << event.depth << ',' << event.vertices_num << ','
+            << event.edges_num;
+  for (const auto color_count : event.colors_counts)
+    std::cout << ',' << color_count;
+  std::cout << '\n';
+}
+
+}  // namespace
+
+// Renders an event trace as the text log or as CSV, in time order
+int main(int argc, char** argv) {
+  const std::string format = argc == 3 ? argv[2] : "text";
+  if ((argc != 2 && argc != 3) || (format != "text" && format != "csv")) {
+    std::cerr << "Usage: " << argv[0] << " <trace> [text|csv]" << std::endl;
+    return 1;
+  }
+  try {
+    auto events = event_trace::read_events(argv[1]);
+    // Each thread's events are in order already, the threads are interleaved
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event& lhs, const Event& rhs) {
+                       return lhs.timestamp_ns < rhs.timestamp_ns;
+                     });
+    if (format == "csv") {
+      print_csv_header();
+      for (const auto& event : events)
+        print_csv(event);
+    } else {
+      for (const auto& event : events)
+        print_text(event);
+    }
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
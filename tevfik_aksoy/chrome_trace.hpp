@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uni_cpp_practice {
+// Spans of the threads written as Chrome trace-event JSON for Perfetto
+// (ui.perfetto.dev) or about://tracing. Nothing is recorded until start(),
+// then every span takes a lock, so there are only a few spans per graph
+class Tracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static Tracer& get_instance() {
+    static Tracer instance;
+    return instance;
+  }
+
+  // Forgets the spans recorded before
+  void start();
+  void stop();
+  bool is_started() const {
+    return is_started_.load(std::memory_order_relaxed);
+  }
+
+  // `name` must outlive the tracer (a literal), a negative graph index is
+  // left out
+  void record(const char* name,
+              Clock::time_point start,
+              Clock::time_point end,
+              int graph_index = -1);
+
+  // Shown instead of the calling thread's number, only while started
+  void set_thread_name(const std::string& name);
+
+  void write(const std::string& filename) const;
+
+ private:
+  struct Record {
+    const char* name = nullptr;
+    Clock::time_point start;
+    Clock::time_point end;
+    std::uint32_t thread_id = 0;
+    int graph_index = -1;
+  };
+
+  std::atomic<bool> is_started_ = false;
+  mutable std::mutex mutex_;
+  Clock::time_point start_time_;
+  std::vector<Record> records_;
+  std::vector<std::pair<std::uint32_t, std::string>> thread_names_;
+
+  Tracer() = default;
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+  Tracer(Tracer&&) = delete;
+  Tracer& operator=(Tracer&&) = delete;
+};
+
+// Records the time from construction to finish() or destruction, only an
+// atomic load while the tracer isn't started
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name, int graph_index = -1);
+  ~TraceSpan() { finish(); }
+
+  void finish();
+  void discard() { is_recording_ = false; }
+
+ private:
+  const char* name_;
+  int graph_index_;
+  bool is_recording_;
+  Tracer::Clock::time_point start_;
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  TraceSpan& operator=(TraceSpan&&) = delete;
+};
+}  // namespace uni_cpp_practice
@@ -0,0 +1,63 @@
+#include "date_time.hpp"
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+
+namespace {
+constexpr auto FORMAT = "%d/%m/%Y %T";
+constexpr int MICROSECONDS_DIGITS = 6;
+
+struct CachedDateAndTime {
+  std::time_t time = -1;
+  std::array<char, 64> buffer;
+  std::size_t length = 0;
+};
+
+CachedDateAndTime& get_cached_date_and_time() {
+  thread_local CachedDateAndTime cached;
+  const auto now =
+      std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  if (now != cached.time) {
+    std::tm local_time;
+    localtime_r(&now, &local_time);
+    cached.length = std::strftime(cached.buffer.data(), cached.buffer.size(),
+                                  FORMAT, &local_time);
+    cached.time = now;
+  }
+  return cached;
+}
+}  // namespace
+
+namespace uni_cpp_practice {
+std::string_view get_date_and_time() {
+  const auto& cached = get_cached_date_and_time();
+  return {cached.buffer.data(), cached.length};
+}
+
+std::string_view get_precise_date_and_time() {
+  static const auto start = std::chrono::steady_clock::now();
+  const auto microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  auto& cached = get_cached_date_and_time();
+  char* const begin = cached.buffer.data();
+  char* const end = begin + cached.buffer.size();
+  char* position = begin + cached.length;
+  *position++ = ' ';
+  *position++ = '[';
+  position = std::to_chars(position, end, microseconds / 1000000).ptr;
+  *position++ = '.';
+  auto fraction = microseconds % 1000000;
+  for (int i = MICROSECONDS_DIGITS - 1; i >= 0; i--) {
+    position[i] = static_cast<char>('0' + fraction % 10);
+    fraction /= 10;
+  }
+  position += MICROSECONDS_DIGITS;
+  *position++ = ']';
+  return {begin, static_cast<std::size_t>(position - begin)};
+}
+}  // namespace uni_cpp_practice
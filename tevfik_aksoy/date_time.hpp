@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string_view>
+
+namespace uni_cpp_practice {
+// Timestamps for log lines, formatted with localtime_r at most once a second
+// per thread. The view stays valid until the next call on the same thread
+
+// "31/01/2024 12:00:00"
+std::string_view get_date_and_time();
+
+// get_date_and_time() followed by the monotonic time since the first call:
+// "31/01/2024 12:00:00 [12.345678]"
+std::string_view get_precise_date_and_time();
+}  // namespace uni_cpp_practice
@@ -1,5 +1,6 @@
 #include "graph_generation_controller.hpp"
 #include <cassert>
+#include "chrome_trace.hpp"
 
 namespace uni_cpp_practice {
 GraphGenerationController::GraphGenerationController(
@@ -36,20 +37,33 @@ void GraphGenerationController::generate(
            &mutex_finished_callback_ = mutex_finished_callback_,
            &graph_generator_ = graph_generator_, &generate_started_callback,
            &generate_finished_callback, &jobs_count = jobs_count, i]() {
+            const auto job_span = TraceSpan("job", i);
             {
+              auto lock_span = TraceSpan("started callback wait", i);
               const std::lock_guard lock(mutex_started_callback_);
+              lock_span.finish();
+              const auto callback_span = TraceSpan("started callback", i);
               generate_started_callback(i);
             }
+            auto generate_span = TraceSpan("generate", i);
             auto graph = graph_generator_.generate();
+            generate_span.finish();
             {
+              auto lock_span = TraceSpan("finished callback wait", i);
               const std::lock_guard lock(mutex_finished_callback_);
+              lock_span.finish();
+              const auto callback_span = TraceSpan("finished callback", i);
               generate_finished_callback(i, std::move(graph));
             }
             ++jobs_count;
           });
     }
   }
-  while (jobs_count < graphs_count_) {
+  {
+    Tracer::get_instance().set_thread_name("controller");
+    const auto span = TraceSpan("wait for jobs");
+    while (jobs_count < graphs_count_) {
+    }
   }
   for (auto& worker : workers_) {
     worker.stop();
@@ -61,16 +75,26 @@ void GraphGenerationController::Worker::start() {
   state_ = State::Working;
   thread_ =
       std::thread([&state_ = state_, &get_job_callback_ = get_job_callback_]() {
+        Tracer::get_instance().set_thread_name("worker");
+        // Polls that find no job are traced as one span
+        std::optional<TraceSpan> idle_span;
         while (true) {
           if (state_ == State::ShouldTerminate) {
             state_ = State::Idle;
             return;
           }
+          auto queue_span = TraceSpan("queue wait");
           const auto job_optional = get_job_callback_();
-          if (job_optional.has_value()) {
-            const auto job_callback = job_optional.value();
-            job_callback();
+          if (!job_optional.has_value()) {
+            queue_span.discard();
+            if (!idle_span.has_value())
+              idle_span.emplace("idle");
+            continue;
           }
+          queue_span.finish();
+          idle_span.reset();
+          const auto job_callback = job_optional.value();
+          job_callback();
         }
       });
 }
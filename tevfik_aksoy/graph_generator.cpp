@@ -4,8 +4,10 @@
 #include <functional>
 #include <iostream>
 #include <list>
+#include <optional>
 #include <random>
 #include <thread>
+#include "chrome_trace.hpp"
 
 using VertexId = uni_cpp_practice::VertexId;
 using Graph = uni_cpp_practice::Graph;
@@ -85,6 +87,7 @@ void GraphGenerator::generate_vertices_and_gray_edges(
   for (int i = 0; i < params_.new_vertices_num; i++) {
     jobs.emplace_back(
         [this, &graph, &graph_mutex, &jobs_count, &source_vertex_id]() {
+          const auto span = TraceSpan("gray branch");
           generate_gray_branch(graph, graph_mutex, source_vertex_id, 1);
           ++jobs_count;
         });
@@ -92,6 +95,9 @@ void GraphGenerator::generate_vertices_and_gray_edges(
 
   std::mutex jobs_mutex;
   const auto worker = [&should_terminate, &jobs_mutex, &jobs]() {
+    Tracer::get_instance().set_thread_name("branch worker");
+    // Polls that find no job are traced as one span
+    std::optional<TraceSpan> idle_span;
     while (true) {
       if (should_terminate) {
         return;
@@ -107,8 +113,11 @@ void GraphGenerator::generate_vertices_and_gray_edges(
         return first_job;
       }();
       if (job_optional.has_value()) {
+        idle_span.reset();
         const auto& job = job_optional.value();
         job();
+      } else if (!idle_span.has_value()) {
+        idle_span.emplace("idle");
       }
     }
   };
@@ -122,7 +131,10 @@ void GraphGenerator::generate_vertices_and_gray_edges(
     threads.push_back(std::thread(worker));
   }
 
-  while (jobs_count < params_.new_vertices_num) {
+  {
+    const auto span = TraceSpan("wait for branches");
+    while (jobs_count < params_.new_vertices_num) {
+    }
   }
 
   should_terminate = true;
@@ -132,6 +144,8 @@ void GraphGenerator::generate_vertices_and_gray_edges(
 }
 
 void generate_green_edges(Graph& graph, std::mutex& mutex) {
+  Tracer::get_instance().set_thread_name("paint");
+  const auto span = TraceSpan("green edges");
   for (const auto& vertex : graph.get_vertices()) {
     if (get_random_probability() < GREEN_EDGE_PROBABILITY) {
       const std::lock_guard lock(mutex);
@@ -141,6 +155,8 @@ void generate_green_edges(Graph& graph, std::mutex& mutex) {
 }
 
 void generate_blue_edges(Graph& graph, std::mutex& mutex) {
+  Tracer::get_instance().set_thread_name("paint");
+  const auto span = TraceSpan("blue edges");
   for (int depth = 0; depth < graph.depth(); depth++) {
     const auto& vertices_in_depth = graph.get_vertices_in_depth(depth);
     for (VertexId j = 0; j < vertices_in_depth.size() - 1; j++) {
@@ -155,6 +171,8 @@ void generate_blue_edges(Graph& graph, std::mutex& mutex) {
 }
 
 void generate_yellow_edges(Graph& graph, std::mutex& mutex) {
+  Tracer::get_instance().set_thread_name("paint");
+  const auto span = TraceSpan("yellow edges");
   for (VertexDepth depth = 1; depth < graph.depth(); depth++) {
     const auto& vertices = graph.get_vertices_in_depth(depth);
     const auto& vertices_next = graph.get_vertices_in_depth(depth + 1);
@@ -175,6 +193,8 @@ void generate_yellow_edges(Graph& graph, std::mutex& mutex) {
 }
 
 void generate_red_edges(Graph& graph, std::mutex& mutex) {
+  Tracer::get_instance().set_thread_name("paint");
+  const auto span = TraceSpan("red edges");
   for (VertexDepth depth = 0; depth < graph.depth() - 1; depth++) {
     const auto& vertices = graph.get_vertices_in_depth(depth);
     const auto& vertices_next = graph.get_vertices_in_depth(depth + 2);
@@ -1,27 +1,220 @@
 #include "graph_printer.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <random>
+#include <unordered_set>
+#include <vector>
 
 namespace {
 
-std::string print_vertex(const uni_cpp_practice::Vertex& vertex) {
-  std::string json_string;
-  json_string +=
-      "\t{ \"id\": " + std::to_string(vertex.id) + ", \"edge_ids\": [";
-  for (int i = 0; i < vertex.get_edge_ids().size(); i++) {
-    json_string += std::to_string(vertex.get_edge_ids()[i]);
-    if (i + 1 != vertex.get_edge_ids().size())
-      json_string += ", ";
-  }
-  json_string += "], \"depth\": " + std::to_string(vertex.depth) + "}";
-  return json_string;
+constexpr int MAX_NUMBER_LENGTH = 11;
+
+// `Output` is std::string or FileWriter, both have append(string_view)
+
+template <typename Output>
+void append_number(Output& output, int number) {
+  std::array<char, MAX_NUMBER_LENGTH> digits;
+  const auto result =
+      std::to_chars(digits.data(), digits.data() + digits.size(), number);
+  output.append(digits.data(), result.ptr - digits.data());
 }
 
-std::string print_edge(const uni_cpp_practice::Edge& edge) {
-  std::string json_string;
-  json_string += "\t{ \"id\": " + std::to_string(edge.id) +
-                 ", \"vertex_ids\": [" + std::to_string(edge.source) + ", " +
-                 std::to_string(edge.destination) + R"(], "color": ")" +
-                 color_to_string(edge.color) + "\" }";
-  return json_string;
+using uni_cpp_practice::EdgeId;
+using uni_cpp_practice::Graph;
+using uni_cpp_practice::LevelOfDetail;
+using uni_cpp_practice::VertexId;
+
+constexpr std::array<uni_cpp_practice::Edge::Color, 5> COLORS = {
+    uni_cpp_practice::Edge::Color::Gray, uni_cpp_practice::Edge::Color::Green,
+    uni_cpp_practice::Edge::Color::Blue, uni_cpp_practice::Edge::Color::Yellow,
+    uni_cpp_practice::Edge::Color::Red};
+
+template <typename Output>
+void print_vertex(const uni_cpp_practice::Vertex& vertex,
+                  const std::vector<EdgeId>& edge_ids,
+                  Output& output) {
+  output.append("\t{ \"id\": ");
+  append_number(output, vertex.id);
+  output.append(", \"edge_ids\": [");
+  for (int i = 0; i < edge_ids.size(); i++) {
+    if (i != 0)
+      output.append(", ");
+    append_number(output, edge_ids[i]);
+  }
+  output.append("], \"depth\": ");
+  append_number(output, vertex.depth);
+  output.append("}");
+}
+
+template <typename Output>
+void print_edge(const uni_cpp_practice::Edge& edge, Output& output) {
+  output.append("\t{ \"id\": ");
+  append_number(output, edge.id);
+  output.append(", \"vertex_ids\": [");
+  append_number(output, edge.source);
+  output.append(", ");
+  append_number(output, edge.destination);
+  output.append(R"(], "color": ")");
+  output.append(color_to_string(edge.color));
+  output.append("\" }");
+}
+
+template <typename Output>
+void print_graph(const uni_cpp_practice::Graph& graph, Output& output) {
+  output.append("{\n\"vertices\": [\n");
+  const auto& vertices = graph.get_vertices();
+  for (int i = 0; i < vertices.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    print_vertex(vertices[i], vertices[i].get_edge_ids(), output);
+  }
+  output.append("\n  ],\n");
+
+  output.append("\"edges\": [\n");
+  const auto& edges = graph.get_edges();
+  for (int i = 0; i < edges.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    print_edge(edges[i], output);
+  }
+  output.append("\n  ]\n}\n");
+}
+
+// `vertex_ids` are printed in order, an edge only when `is_selected` takes
+// its other end as well. Looks at the edges of `vertex_ids` and no others.
+template <typename Output, typename IsSelected>
+void print_subgraph(const Graph& graph,
+                    const std::vector<VertexId>& vertex_ids,
+                    const IsSelected& is_selected,
+                    Output& output) {
+  const auto& vertices = graph.get_vertices();
+  const auto& edges = graph.get_edges();
+  std::vector<EdgeId> vertex_edge_ids;
+  std::vector<EdgeId> edge_ids;
+  output.append("{\n\"vertices\": [\n");
+  for (std::size_t i = 0; i < vertex_ids.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    const auto& vertex = vertices[vertex_ids[i]];
+    vertex_edge_ids.clear();
+    for (const auto& edge_id : vertex.get_edge_ids()) {
+      const auto& edge = edges[edge_id];
+      const bool is_source = edge.source == vertex.id;
+      if (!is_selected(is_source ? edge.destination : edge.source))
+        continue;
+      vertex_edge_ids.push_back(edge_id);
+      // Every edge is taken once, from its source
+      if (is_source)
+        edge_ids.push_back(edge_id);
+    }
+    print_vertex(vertex, vertex_edge_ids, output);
+  }
+  output.append("\n  ],\n");
+
+  std::sort(edge_ids.begin(), edge_ids.end());
+  output.append("\"edges\": [\n");
+  for (std::size_t i = 0; i < edge_ids.size(); i++) {
+    if (i != 0)
+      output.append(",\n");
+    print_edge(edges[edge_ids[i]], output);
+  }
+  output.append("\n  ]\n}\n");
+}
+
+template <typename Output>
+void print_depth_limited(const Graph& graph,
+                         const uni_cpp_practice::VertexDepth& max_depth,
+                         Output& output) {
+  std::vector<VertexId> vertex_ids;
+  for (int depth = 0; depth <= std::min(max_depth, graph.depth()); depth++) {
+    const auto& depth_vertex_ids = graph.get_vertices_in_depth(depth);
+    vertex_ids.insert(vertex_ids.end(), depth_vertex_ids.begin(),
+                      depth_vertex_ids.end());
+  }
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  const auto& vertices = graph.get_vertices();
+  print_subgraph(
+      graph, vertex_ids,
+      [&vertices, max_depth](const VertexId& vertex_id) {
+        return vertices[vertex_id].depth <= max_depth;
+      },
+      output);
+}
+
+template <typename Output>
+void print_sampled(const Graph& graph,
+                   int sample_size,
+                   unsigned int seed,
+                   Output& output) {
+  // Floyd's algorithm: `sample_size` steps whatever the number of vertices
+  const int vertices_count = graph.get_vertices().size();
+  sample_size = std::min(sample_size, vertices_count);
+  std::mt19937 random_engine(seed);
+  std::unordered_set<VertexId> sample;
+  sample.reserve(sample_size);
+  for (int last = vertices_count - sample_size; last < vertices_count;
+       last++) {
+    const VertexId vertex_id =
+        std::uniform_int_distribution<VertexId>(0, last)(random_engine);
+    if (!sample.insert(vertex_id).second)
+      sample.insert(last);
+  }
+
+  std::vector<VertexId> vertex_ids(sample.begin(), sample.end());
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  print_subgraph(
+      graph, vertex_ids,
+      [&sample](const VertexId& vertex_id) { return sample.count(vertex_id); },
+      output);
+}
+
+template <typename Output>
+void print_summary(const Graph& graph, Output& output) {
+  output.append("{\n\"depth\": ");
+  append_number(output, graph.depth());
+  output.append(",\n\"vertices\": ");
+  append_number(output, graph.get_vertices().size());
+  output.append(",\n\"edges\": ");
+  append_number(output, graph.get_edges().size());
+  output.append(",\n\"vertices_per_depth\": [");
+  for (int depth = 0; depth <= graph.depth(); depth++) {
+    if (depth != 0)
+      output.append(", ");
+    append_number(output, graph.get_vertices_in_depth(depth).size());
+  }
+  output.append("],\n\"edges_per_color\": { ");
+  for (std::size_t i = 0; i < COLORS.size(); i++) {
+    if (i != 0)
+      output.append(", ");
+    output.append("\"");
+    output.append(color_to_string(COLORS[i]));
+    output.append("\": ");
+    append_number(output, graph.get_colored_edges(COLORS[i]).size());
+  }
+  output.append(" }\n}\n");
+}
+
+template <typename Output>
+void print_level_of_detail(const Graph& graph,
+                           const LevelOfDetail& level_of_detail,
+                           Output& output) {
+  switch (level_of_detail.mode) {
+    case LevelOfDetail::Mode::Full:
+      print_graph(graph, output);
+      return;
+    case LevelOfDetail::Mode::DepthLimited:
+      print_depth_limited(graph, level_of_detail.max_depth, output);
+      return;
+    case LevelOfDetail::Mode::Sampled:
+      print_sampled(graph, level_of_detail.sample_size, level_of_detail.seed,
+                    output);
+      return;
+    case LevelOfDetail::Mode::Summary:
+      print_summary(graph, output);
+      return;
+  }
 }
 
 }  // namespace
@@ -29,21 +222,15 @@ std::string print_edge(const uni_cpp_practice::Edge& edge) {
 namespace uni_cpp_practice {
 std::string GraphPrinter::print() const {
   std::string json_string;
-  json_string += "{\n\"vertices\": [\n";
-  for (int i = 0; i < graph_.get_vertices().size(); i++) {
-    json_string += print_vertex(graph_.get_vertices()[i]);
-    if (i + 1 != graph_.get_vertices().size())
-      json_string += ",\n";
-  }
-  json_string += "\n  ],\n";
-
-  json_string += "\"edges\": [\n";
-  for (int i = 0; i < graph_.get_edges().size(); i++) {
-    json_string += print_edge(graph_.get_edges()[i]);
-    if (i + 1 != graph_.get_edges().size())
-      json_string += ",\n";
-  }
-  json_string += "\n  ]\n}\n";
+  print(json_string);
   return json_string;
 }
+
+void GraphPrinter::print(std::string& buffer) const {
+  print_level_of_detail(graph_, level_of_detail_, buffer);
+}
+
+void GraphPrinter::print(FileWriter& writer) const {
+  print_level_of_detail(graph_, level_of_detail_, writer);
+}
 }  // namespace uni_cpp_practice
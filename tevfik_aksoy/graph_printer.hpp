@@ -1,14 +1,56 @@
 #pragma once
 
+#include <string>
+#include "file_writer.hpp"
 #include "graph.hpp"
 namespace uni_cpp_practice {
+// Which part of the graph is printed. All modes but Full take time
+// proportional to the output instead of the graph size.
+struct LevelOfDetail {
+  enum class Mode { Full, DepthLimited, Sampled, Summary };
+
+  Mode mode = Mode::Full;
+  // DepthLimited: vertices up to this depth and edges between them
+  VertexDepth max_depth = 0;
+  // Sampled: uniformly chosen vertices and edges between them
+  int sample_size = 0;
+  unsigned int seed = 0;
+
+  static LevelOfDetail depth_limited(const VertexDepth& max_depth) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::DepthLimited;
+    level_of_detail.max_depth = max_depth;
+    return level_of_detail;
+  }
+  static LevelOfDetail sampled(int sample_size, unsigned int seed) {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Sampled;
+    level_of_detail.sample_size = sample_size;
+    level_of_detail.seed = seed;
+    return level_of_detail;
+  }
+  // Vertices per depth and edges per color, no vertices or edges themselves
+  static LevelOfDetail summary() {
+    LevelOfDetail level_of_detail;
+    level_of_detail.mode = Mode::Summary;
+    return level_of_detail;
+  }
+};
+
 class GraphPrinter {
  public:
-  explicit GraphPrinter(const Graph& graph) : graph_(graph){};
+  explicit GraphPrinter(const Graph& graph,
+                        const LevelOfDetail& level_of_detail = LevelOfDetail())
+      : graph_(graph), level_of_detail_(level_of_detail){};
 
   std::string print() const;
+  // Appends to the buffer, which can be reused between graphs
+  void print(std::string& buffer) const;
+  // Streams vertex by vertex, never holding the whole JSON in memory
+  void print(FileWriter& writer) const;
 
  private:
   const Graph& graph_;
+  const LevelOfDetail level_of_detail_;
 };
 }  // namespace uni_cpp_practice
@@ -1,10 +1,11 @@
 #include <array>
-#include <chrono>
 #include <filesystem>
-#include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <random>
 #include <string>
+#include "chrome_trace.hpp"
+#include "date_time.hpp"
+#include "file_writer.hpp"
 #include "graph.hpp"
 #include "graph_generation_controller.hpp"
 #include "graph_printer.hpp"
@@ -13,17 +14,13 @@
 using Graph = uni_cpp_practice::Graph;
 using Edge = uni_cpp_practice::Edge;
 using GraphPrinter = uni_cpp_practice::GraphPrinter;
+using LevelOfDetail = uni_cpp_practice::LevelOfDetail;
 using GraphGenerator = uni_cpp_practice::GraphGenerator;
 using GraphGenerationController = uni_cpp_practice::GraphGenerationController;
 using Logger = uni_cpp_practice::Logger;
-
-std::string get_date_and_time() {
-  std::time_t now =
-      std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-  std::stringstream date_time_string;
-  date_time_string << std::put_time(std::localtime(&now), "%d/%m/%Y %T");
-  return date_time_string.str();
-}
+using FileWriter = uni_cpp_practice::FileWriter;
+using Tracer = uni_cpp_practice::Tracer;
+using uni_cpp_practice::get_date_and_time;
 
 int handle_depth_input() {
   int max_depth = 0;
@@ -73,9 +70,43 @@ int handle_graphs_count_input() {
   return graphs_count;
 }
 
+int handle_non_negative_input(const std::string& name) {
+  int value = 0;
+  std::cout << "Enter " << name << ": ";
+  do {
+    std::cin >> value;
+    if (value < 0)
+      std::cerr << name << " can not be negative!\n"
+                << "Enter a non-negative " << name << ": ";
+  } while (value < 0);
+  return value;
+}
+
+// What the graph JSON files hold, the whole graph unless asked otherwise
+LevelOfDetail handle_level_of_detail_input() {
+  std::string mode;
+  std::cout << "Enter output mode (full, depth_limited, sampled, summary): ";
+  while (true) {
+    std::cin >> mode;
+    if (mode == "full" || !std::cin)
+      return LevelOfDetail();
+    if (mode == "depth_limited")
+      return LevelOfDetail::depth_limited(
+          handle_non_negative_input("output max_depth"));
+    if (mode == "sampled")
+      return LevelOfDetail::sampled(
+          handle_non_negative_input("output sample_size"),
+          std::random_device()());
+    if (mode == "summary")
+      return LevelOfDetail::summary();
+    std::cerr << "Unknown output mode!\n"
+                 "Enter full, depth_limited, sampled or summary: ";
+  }
+}
+
 void log_start(Logger& logger, const int graph_number) {
-  logger.log(get_date_and_time() + ": Graph " + std::to_string(graph_number) +
-             ", Generation Started\n");
+  logger.log(std::string(get_date_and_time()) + ": Graph " +
+             std::to_string(graph_number) + ", Generation Started\n");
 }
 
 void log_depth(Logger& logger, const Graph& graph) {
@@ -99,8 +130,8 @@ void log_colors(Logger& logger, const Graph& graph) {
 }
 
 void log_end(Logger& logger, const Graph& graph, int graph_number) {
-  logger.log(get_date_and_time() + ": Graph " + std::to_string(graph_number) +
-             ", Generation Finished {  \n");
+  logger.log(std::string(get_date_and_time()) + ": Graph " +
+             std::to_string(graph_number) + ", Generation Finished {  \n");
   logger.log("  depth: " + std::to_string(graph.depth()) + ",\n");
   logger.log("  vertices: " + std::to_string(graph.get_vertices().size()) +
              ", [");
@@ -113,18 +144,18 @@ void log_end(Logger& logger, const Graph& graph, int graph_number) {
 
 void write_to_file(const GraphPrinter& graph_printer,
                    const std::string& filename) {
-  std::ofstream jsonfile(filename, std::ios::out);
-  if (!jsonfile.is_open())
-    throw std::runtime_error("Error while opening the JSON file!");
-  jsonfile << graph_printer.print();
+  auto jsonfile = FileWriter(filename);
+  graph_printer.print(jsonfile);
   jsonfile.close();
 }
 
-int main() {
+// `main <file>` also writes a Chrome trace of the threads to the file
+int main(int argc, char** argv) {
   const int threads_count = handle_threads_count_input();
   const int graphs_count = handle_graphs_count_input();
   const int max_depth = handle_depth_input();
   const int new_vertices_num = handle_new_vertices_num_input();
+  const auto level_of_detail = handle_level_of_detail_input();
   const auto params = GraphGenerator::Params(max_depth, new_vertices_num);
   auto generation_controller =
       GraphGenerationController(threads_count, graphs_count, params);
@@ -134,14 +165,21 @@ int main() {
   auto graphs = std::vector<Graph>();
   graphs.reserve(graphs_count);
 
+  auto& tracer = Tracer::get_instance();
+  if (argc > 1)
+    tracer.start();
   generation_controller.generate(
       [&logger](int index) { log_start(logger, index); },
-      [&logger, &graphs](int index, Graph graph) {
+      [&logger, &graphs, &level_of_detail](int index, Graph graph) {
         log_end(logger, graph, index);
         graphs.push_back(graph);
-        const auto graph_printer = GraphPrinter(graph);
+        const auto graph_printer = GraphPrinter(graph, level_of_detail);
         write_to_file(graph_printer,
                       "./temp/graph_" + std::to_string(index) + ".json");
       });
+  if (argc > 1) {
+    tracer.stop();
+    tracer.write(argv[1]);
+  }
   return 0;
 }